@@ -54,6 +54,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -320,6 +321,31 @@ static int lo_ifup(FAR struct net_driver_s *dev)
   wd_start(&priv->lo_polldog, LO_WDDELAY,
            lo_poll_expiry, (wdparm_t)priv);
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  /* Loop packets back in an I/O buffer so that the received data can be
+   * queued without copying it.  Keep using the static buffer if there is
+   * no I/O buffer that can hold a full packet.
+   */
+
+  if (dev->d_iob == NULL)
+    {
+      FAR struct iob_s *iob;
+
+      iob = iob_tryalloc_len(sizeof(g_iobuffer), false, IOBUSER_NET_NETDEV);
+      if (iob != NULL && IOB_BUFSIZE(iob) < sizeof(g_iobuffer))
+        {
+          iob_free(iob, IOBUSER_NET_NETDEV);
+          iob = NULL;
+        }
+
+      if (iob != NULL)
+        {
+          dev->d_iob = iob;
+          dev->d_buf = iob->io_data;
+        }
+    }
+#endif
+
   priv->lo_bifup = true;
   return OK;
 }
@@ -348,6 +374,17 @@ static int lo_ifdown(FAR struct net_driver_s *dev)
 
   wd_cancel(&priv->lo_polldog);
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  /* Release the I/O buffer, if any, and go back to the static buffer */
+
+  if (dev->d_iob != NULL)
+    {
+      iob_free(dev->d_iob, IOBUSER_NET_NETDEV);
+      dev->d_iob = NULL;
+      dev->d_buf = g_iobuffer;
+    }
+#endif
+
   /* Mark the device "down" */
 
   priv->lo_bifup = false;
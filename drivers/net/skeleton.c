@@ -314,7 +314,10 @@ static int skel_txpoll(FAR struct net_driver_s *dev)
           skel_transmit(priv);
 
           /* Check if there is room in the device to hold another packet.
-           * If not, return a non-zero value to terminate the poll.
+           * If not, return a non-zero value to terminate the poll.  If so,
+           * point d_buf to the next free TX buffer and continue the poll.
+           * A TCP connection may then send several segments in this poll
+           * (see CONFIG_NET_TCP_TXBATCH).
            */
         }
     }
@@ -1275,6 +1275,7 @@ static int telnet_io_main(int argc, FAR char** argv)
               priv->td_fds.sem     = &g_iosem;
               priv->td_fds.events  = POLLIN | POLLHUP | POLLERR;
               priv->td_fds.revents = 0;
+              priv->td_fds.cb      = NULL;
 
               psock_poll(&priv->td_psock, &priv->td_fds, TRUE);
             }
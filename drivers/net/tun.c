@@ -61,6 +61,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/arp.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ethernet.h>
@@ -105,6 +106,16 @@
 
 #define NET_TUN_PKTSIZE ((CONFIG_NET_TUN_PKTSIZE + CONFIG_NET_GUARDSIZE + 1) & ~1)
 
+/* Outgoing packets are queued in a ring of TX buffers until they are read */
+
+#ifndef CONFIG_NET_TUN_NTXBUFFERS
+#  define CONFIG_NET_TUN_NTXBUFFERS 1
+#endif
+
+#define TUN_TXTAIL(p) \
+  (((p)->read_head + (p)->read_count) % CONFIG_NET_TUN_NTXBUFFERS)
+#define TUN_TXFULL(p) ((p)->read_count >= CONFIG_NET_TUN_NTXBUFFERS)
+
 /* TX poll delay = 1 seconds.
  * CLK_TCK is the number of clock ticks per second
  */
@@ -137,20 +148,25 @@ struct tun_device_s
   bool              bifup;     /* true:ifup false:ifdown */
   bool              read_wait;
   bool              write_wait;
+  uint8_t           read_head; /* Oldest packet in read_buf[] */
+  uint8_t           read_count;
   struct wdog_s     txpoll;    /* TX poll timer */
   struct work_s     work;      /* For deferring poll work to the work queue */
   FAR struct pollfd *poll_fds;
   sem_t             waitsem;
   sem_t             read_wait_sem;
   sem_t             write_wait_sem;
-  size_t            read_d_len;
+  size_t            read_d_len[CONFIG_NET_TUN_NTXBUFFERS];
   size_t            write_d_len;
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  FAR struct iob_s  *rx_iob;   /* I/O buffer for the next packet written */
+#endif
 
   /* These packet buffer arrays required 16-bit alignment.  That alignment
    * is assured only by the preceding wide data types.
    */
 
-  uint8_t           read_buf[NET_TUN_PKTSIZE];
+  uint8_t           read_buf[CONFIG_NET_TUN_NTXBUFFERS][NET_TUN_PKTSIZE];
   uint8_t           write_buf[NET_TUN_PKTSIZE];
 
   /* This holds the information visible to the NuttX network */
@@ -174,6 +190,7 @@ static void tun_unlock(FAR struct tun_device_s *priv);
 /* Common TX logic */
 
 static void tun_fd_transmit(FAR struct tun_device_s *priv);
+static int  tun_txqueue(FAR struct tun_device_s *priv);
 static int  tun_txpoll(FAR struct net_driver_s *dev);
 #ifdef CONFIG_NET_ETHERNET
 static int  tun_txpoll_tap(FAR struct net_driver_s *dev);
@@ -189,6 +206,9 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv);
 static void tun_net_receive_tun(FAR struct tun_device_s *priv);
 
 static void tun_txdone(FAR struct tun_device_s *priv);
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+static FAR uint8_t *tun_rxbuffer(FAR struct tun_device_s *priv);
+#endif
 
 /* Watchdog timer expirations */
 
@@ -344,6 +364,41 @@ static void tun_fd_transmit(FAR struct tun_device_s *priv)
   tun_pollnotify(priv, POLLIN);
 }
 
+/****************************************************************************
+ * Name: tun_txqueue
+ *
+ * Description:
+ *   Queue the packet in d_buf until it is read by the application and
+ *   point d_buf to the next free TX buffer, if any.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   Zero if the poll may continue; one if all TX buffers are in use.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int tun_txqueue(FAR struct tun_device_s *priv)
+{
+  DEBUGASSERT(priv->dev.d_buf == priv->read_buf[TUN_TXTAIL(priv)]);
+
+  priv->read_d_len[TUN_TXTAIL(priv)] = priv->dev.d_len;
+  priv->read_count++;
+  tun_fd_transmit(priv);
+
+  if (TUN_TXFULL(priv))
+    {
+      return 1;
+    }
+
+  priv->dev.d_buf = priv->read_buf[TUN_TXTAIL(priv)];
+  return 0;
+}
+
 /****************************************************************************
  * Name: tun_txpoll
  *
@@ -445,10 +500,7 @@ static int tun_txpoll_tap(FAR struct net_driver_s *dev)
         {
           /* Send the packet */
 
-          priv->read_d_len = priv->dev.d_len;
-          tun_fd_transmit(priv);
-
-          return 1;
+          return tun_txqueue(priv);
         }
     }
 
@@ -499,10 +551,7 @@ static int tun_txpoll_tun(FAR struct net_driver_s *dev)
         {
           /* Send the packet */
 
-          priv->read_d_len = priv->dev.d_len;
-          tun_fd_transmit(priv);
-
-          return 1;
+          return tun_txqueue(priv);
         }
     }
 
@@ -756,10 +805,54 @@ static void tun_txdone(FAR struct tun_device_s *priv)
 
   /* Then poll the network for new XMIT data */
 
-  priv->dev.d_buf = priv->read_buf;
+  priv->dev.d_buf = priv->read_buf[TUN_TXTAIL(priv)];
   devif_poll(&priv->dev, tun_txpoll);
 }
 
+/****************************************************************************
+ * Name: tun_rxbuffer
+ *
+ * Description:
+ *   Return the buffer that receives the next packet written to the device.
+ *   This is an I/O buffer, if one of the full packet size is available, so
+ *   that the network can queue the received data without copying it.
+ *   Otherwise, it is write_buf.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   The receive buffer
+ *
+ * Assumptions:
+ *   The device is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+static FAR uint8_t *tun_rxbuffer(FAR struct tun_device_s *priv)
+{
+  if (priv->rx_iob == NULL)
+    {
+      priv->rx_iob = iob_tryalloc_len(NET_TUN_PKTSIZE, false,
+                                      IOBUSER_NET_NETDEV);
+      if (priv->rx_iob == NULL)
+        {
+          return priv->write_buf;
+        }
+
+      if (IOB_BUFSIZE(priv->rx_iob) < NET_TUN_PKTSIZE)
+        {
+          iob_free(priv->rx_iob, IOBUSER_NET_NETDEV);
+          priv->rx_iob = NULL;
+          return priv->write_buf;
+        }
+    }
+
+  return priv->rx_iob->io_data;
+}
+#endif
+
 /****************************************************************************
  * Name: tun_poll_work
  *
@@ -801,11 +894,11 @@ static void tun_poll_work(FAR void *arg)
    * the TX poll if he are unable to accept another packet for transmission.
    */
 
-  if (priv->read_d_len == 0)
+  if (!TUN_TXFULL(priv))
     {
       /* If so, poll the network for new XMIT data. */
 
-      priv->dev.d_buf = priv->read_buf;
+      priv->dev.d_buf = priv->read_buf[TUN_TXTAIL(priv)];
       devif_timer(&priv->dev, TUN_WDDELAY, tun_txpoll);
     }
 
@@ -953,7 +1046,7 @@ static void tun_txavail_work(FAR void *arg)
 
   /* Check if there is room to hold another network packet. */
 
-  if (priv->read_d_len != 0)
+  if (TUN_TXFULL(priv))
     {
       tun_unlock(priv);
       return;
@@ -964,7 +1057,7 @@ static void tun_txavail_work(FAR void *arg)
     {
       /* Poll the network for new XMIT data */
 
-      priv->dev.d_buf = priv->read_buf;
+      priv->dev.d_buf = priv->read_buf[TUN_TXTAIL(priv)];
       devif_poll(&priv->dev, tun_txpoll);
     }
 
@@ -1141,6 +1234,14 @@ static void tun_dev_uninit(FAR struct tun_device_s *priv)
 
   netdev_unregister(&priv->dev);
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  if (priv->rx_iob != NULL)
+    {
+      iob_free(priv->rx_iob, IOBUSER_NET_NETDEV);
+      priv->rx_iob = NULL;
+    }
+#endif
+
   nxsem_destroy(&priv->waitsem);
   nxsem_destroy(&priv->read_wait_sem);
   nxsem_destroy(&priv->write_wait_sem);
@@ -1218,13 +1319,44 @@ static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
 
       if (priv->write_d_len == 0)
         {
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+          FAR uint8_t *rxbuf = tun_rxbuffer(priv);
+
+          memcpy(rxbuf, buffer, buflen);
+
+          net_lock();
+          priv->dev.d_buf = rxbuf;
+          priv->dev.d_iob = rxbuf != priv->write_buf ? priv->rx_iob : NULL;
+#else
           memcpy(priv->write_buf, buffer, buflen);
 
           net_lock();
           priv->dev.d_buf = priv->write_buf;
+#endif
           priv->dev.d_len = buflen;
 
           tun_net_receive(priv);
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+          /* The network may have exchanged the I/O buffer.  Any response is
+           * read from write_buf.
+           */
+
+          if (priv->dev.d_iob != NULL)
+            {
+              priv->rx_iob    = priv->dev.d_iob;
+              priv->dev.d_iob = NULL;
+
+              if (priv->write_d_len > 0)
+                {
+                  memcpy(priv->write_buf, priv->dev.d_buf,
+                         priv->write_d_len);
+                }
+
+              priv->dev.d_buf = priv->write_buf;
+            }
+#endif
+
           net_unlock();
 
           nwritten = buflen;
@@ -1297,17 +1429,21 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
 
       /* Check if there are data to read in read buffer */
 
-      if (priv->read_d_len > 0)
+      if (priv->read_count > 0)
         {
-          if (buflen < priv->read_d_len)
+          int head = priv->read_head;
+
+          if (buflen < priv->read_d_len[head])
             {
               nread = -EINVAL;
               break;
             }
 
-          memcpy(buffer, priv->read_buf, priv->read_d_len);
-          nread = priv->read_d_len;
-          priv->read_d_len = 0;
+          memcpy(buffer, priv->read_buf[head], priv->read_d_len[head]);
+          nread = priv->read_d_len[head];
+
+          priv->read_head = (head + 1) % CONFIG_NET_TUN_NTXBUFFERS;
+          priv->read_count--;
 
           net_lock();
           tun_txdone(priv);
@@ -1378,7 +1514,7 @@ int tun_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
        * So check it too.
        */
 
-      if (priv->read_d_len != 0 || priv->write_d_len != 0)
+      if (priv->read_count != 0 || priv->write_d_len != 0)
         {
           eventset |= (fds->events & POLLIN);
         }
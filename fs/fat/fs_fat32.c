@@ -584,6 +584,10 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
           ff->ff_currentcluster   = cluster;
           ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
           ff->ff_sectorsincluster = fs->fs_fatsecperclus;
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+          fat_extentadd(fs, ff, filep->f_pos, cluster);
+#endif
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -850,6 +854,10 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
           ff->ff_currentcluster   = cluster;
           ff->ff_sectorsincluster = fs->fs_fatsecperclus;
           ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+          fat_extentadd(fs, ff, filep->f_pos, cluster);
+#endif
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -1157,6 +1165,17 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+      /* Skip directly to the cluster containing the requested position
+       * if it was recorded in the extents of the file.  Otherwise, skip
+       * to the last recorded cluster and follow the chain from there.
+       */
+
+      filep->f_pos = fat_extentseek(fs, ff, position, &cluster);
+      position    -= filep->f_pos;
+#endif
+
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1227,6 +1246,10 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
 
           filep->f_pos += clustersize;
           position     -= clustersize;
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+          fat_extentadd(fs, ff, filep->f_pos, cluster);
+#endif
         }
 
       /* We get here after we have found the sector containing
@@ -1547,6 +1570,9 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#ifdef CONFIG_FAT_EXTENTCACHE
+  newff->ff_nextents         = 0;                          /* No extents recorded */
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -2243,6 +2269,13 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+  /* Write back any sectors that are still buffered */
+
+  if (fs->fs_mounted)
+    {
+      fat_fscacheflush(fs);
+    }
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2275,6 +2308,14 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  fat_cacheuninitialize(fs);
+#endif
+
+#ifdef CONFIG_FAT_FREEMAP
+  fat_freemapfree(fs);
+#endif
+
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
   return OK;
@@ -857,6 +857,33 @@
  * is mounted with a fat32 filesystem.
  */
 
+#ifdef CONFIG_FAT_SECTORCACHE
+/* This structure describes one sector held in the sector cache of a
+ * mountpoint.
+ */
+
+struct fat_cacheentry_s
+{
+  off_t    ce_sector;              /* The sector in ce_buffer or -1 if unused */
+  uint32_t ce_age;                 /* Time of last access for LRU replacement */
+  bool     ce_dirty;               /* true: ce_buffer must be written back */
+  uint8_t *ce_buffer;              /* Holds one sector from the device */
+};
+#endif
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+/* This structure maps a run of contiguous clusters of a file.  The extents
+ * of a file are kept in the order of their file cluster index.
+ */
+
+struct fat_extent_s
+{
+  uint32_t fe_fileclus;            /* Cluster index of the run in the file */
+  uint32_t fe_cluster;             /* First cluster of the run on the media */
+  uint32_t fe_count;               /* Number of clusters in the run */
+};
+#endif
+
 struct fat_file_s;
 struct fat_mountpt_s
 {
@@ -886,6 +913,19 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#ifdef CONFIG_FAT_SECTORCACHE
+  uint32_t fs_cacheage;            /* Access counter for LRU replacement */
+  uint8_t *fs_cachebuffer;         /* Sector buffers of the sector cache */
+  struct fat_cacheentry_s fs_cache[CONFIG_FAT_SECTORCACHE_NSECTORS];
+#endif
+#ifdef CONFIG_FAT_FREEMAP
+  uint32_t *fs_freemap;            /* One bit per cluster, set if the cluster
+                                    * is in use.  NULL until first needed */
+#endif
+#ifdef CONFIG_FAT_EXTENTCACHE
+  uint32_t fs_chaingen;            /* Incremented when clusters are removed
+                                    * from any cluster chain */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -907,6 +947,11 @@ struct fat_file_s
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#ifdef CONFIG_FAT_EXTENTCACHE
+  uint8_t  ff_nextents;            /* Number of valid entries in ff_extents */
+  uint32_t ff_extentgen;           /* Value of fs_chaingen for ff_extents */
+  struct fat_extent_s ff_extents[CONFIG_FAT_EXTENTCACHE_NEXTENTS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1038,6 +1083,8 @@ EXTERN int    fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,
                          off_t sector, unsigned int nsectors);
 EXTERN int    fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer,
                           off_t sector, unsigned int nsectors);
+EXTERN int    fat_writesector(struct fat_mountpt_s *fs, uint8_t *buffer,
+                              off_t sector);
 
 /* Cluster / cluster chain access helpers */
 
@@ -1093,6 +1140,43 @@ EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(struct fat_mountpt_s *fs,
                                     struct fat_file_s *ff);
 
+/* LRU sector cache shared by the FAT, directory and file data sectors */
+
+#ifdef CONFIG_FAT_SECTORCACHE
+EXTERN int    fat_cacheinitialize(struct fat_mountpt_s *fs);
+EXTERN void   fat_cacheuninitialize(struct fat_mountpt_s *fs);
+EXTERN int    fat_cacheread(struct fat_mountpt_s *fs, uint8_t *buffer,
+                            off_t sector);
+EXTERN int    fat_cachewrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                             off_t sector);
+EXTERN int    fat_cacheflush(struct fat_mountpt_s *fs);
+EXTERN void   fat_cachehwread(struct fat_mountpt_s *fs, uint8_t *buffer,
+                              off_t sector, unsigned int nsectors);
+EXTERN void   fat_cachehwwrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                               off_t sector, unsigned int nsectors);
+#endif
+
+/* Free cluster bitmap */
+
+#ifdef CONFIG_FAT_FREEMAP
+EXTERN int    fat_freemapbuild(struct fat_mountpt_s *fs);
+EXTERN void   fat_freemapfree(struct fat_mountpt_s *fs);
+EXTERN int32_t fat_freemapfind(struct fat_mountpt_s *fs,
+                               uint32_t startcluster);
+EXTERN void   fat_freemapupdate(struct fat_mountpt_s *fs, uint32_t cluster,
+                                bool inuse);
+#endif
+
+/* Cluster chain extent cache of open files */
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+EXTERN off_t  fat_extentseek(struct fat_mountpt_s *fs,
+                             struct fat_file_s *ff, off_t position,
+                             int32_t *cluster);
+EXTERN void   fat_extentadd(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                            off_t position, uint32_t cluster);
+#endif
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(struct fat_mountpt_s *fs);
@@ -0,0 +1,349 @@
+/****************************************************************************
+ * fs/fat/fs_fat32cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/fat.h>
+
+#include "inode/inode.h"
+#include "fs_fat32.h"
+
+#ifdef CONFIG_FAT_SECTORCACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cachefind
+ *
+ * Description:
+ *   Return the cache entry that holds 'sector' or NULL if the sector is not
+ *   in the cache.
+ *
+ ****************************************************************************/
+
+static FAR struct fat_cacheentry_s *
+fat_cachefind(FAR struct fat_mountpt_s *fs, off_t sector)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      if (fs->fs_cache[i].ce_sector == sector)
+        {
+          return &fs->fs_cache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: fat_cachevictim
+ *
+ * Description:
+ *   Select an unused cache entry or else the least recently used one.  A
+ *   dirty entry is written back before it is returned.
+ *
+ ****************************************************************************/
+
+static FAR struct fat_cacheentry_s *
+fat_cachevictim(FAR struct fat_mountpt_s *fs, FAR int *ret)
+{
+  FAR struct fat_cacheentry_s *victim = &fs->fs_cache[0];
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      if (fs->fs_cache[i].ce_sector < 0)
+        {
+          victim = &fs->fs_cache[i];
+          break;
+        }
+
+      if ((int32_t)(fs->fs_cache[i].ce_age - victim->ce_age) < 0)
+        {
+          victim = &fs->fs_cache[i];
+        }
+    }
+
+  *ret = OK;
+  if (victim->ce_dirty)
+    {
+      *ret = fat_writesector(fs, victim->ce_buffer, victim->ce_sector);
+      if (*ret < 0)
+        {
+          return NULL;
+        }
+
+      victim->ce_dirty = false;
+    }
+
+  victim->ce_sector = -1;
+  return victim;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cacheinitialize
+ *
+ * Description:
+ *   Allocate the sector buffers of the sector cache.  This must be called
+ *   before the first access to the device.
+ *
+ ****************************************************************************/
+
+int fat_cacheinitialize(FAR struct fat_mountpt_s *fs)
+{
+  int i;
+
+  fs->fs_cachebuffer = (FAR uint8_t *)
+    fat_io_alloc(fs->fs_hwsectorsize * CONFIG_FAT_SECTORCACHE_NSECTORS);
+  if (fs->fs_cachebuffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      fs->fs_cache[i].ce_sector = -1;
+      fs->fs_cache[i].ce_age    = 0;
+      fs->fs_cache[i].ce_dirty  = false;
+      fs->fs_cache[i].ce_buffer = &fs->fs_cachebuffer[i *
+                                                      fs->fs_hwsectorsize];
+    }
+
+  fs->fs_cacheage = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cacheuninitialize
+ *
+ * Description:
+ *   Free the sector buffers of the sector cache.  Dirty sectors are
+ *   discarded; fat_cacheflush() must be called first to keep them.
+ *
+ ****************************************************************************/
+
+void fat_cacheuninitialize(FAR struct fat_mountpt_s *fs)
+{
+  int i;
+
+  if (fs->fs_cachebuffer != NULL)
+    {
+      fat_io_free(fs->fs_cachebuffer,
+                  fs->fs_hwsectorsize * CONFIG_FAT_SECTORCACHE_NSECTORS);
+      fs->fs_cachebuffer = NULL;
+    }
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      fs->fs_cache[i].ce_sector = -1;
+      fs->fs_cache[i].ce_dirty  = false;
+      fs->fs_cache[i].ce_buffer = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cacheread
+ *
+ * Description:
+ *   Copy one sector into 'buffer'.  The sector is read from the device
+ *   only if it is not already in the cache.
+ *
+ ****************************************************************************/
+
+int fat_cacheread(FAR struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                  off_t sector)
+{
+  FAR struct fat_cacheentry_s *entry;
+  int ret;
+
+  entry = fat_cachefind(fs, sector);
+  if (entry == NULL)
+    {
+      entry = fat_cachevictim(fs, &ret);
+      if (entry == NULL)
+        {
+          return ret;
+        }
+
+      ret = fat_hwread(fs, entry->ce_buffer, sector, 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      entry->ce_sector = sector;
+    }
+
+  entry->ce_age = ++fs->fs_cacheage;
+  memcpy(buffer, entry->ce_buffer, fs->fs_hwsectorsize);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachewrite
+ *
+ * Description:
+ *   Copy one modified sector from 'buffer' into the cache.  The sector is
+ *   written to the device when it is evicted or when the cache is flushed.
+ *
+ ****************************************************************************/
+
+int fat_cachewrite(FAR struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                   off_t sector)
+{
+  FAR struct fat_cacheentry_s *entry;
+  int ret;
+
+  entry = fat_cachefind(fs, sector);
+  if (entry == NULL)
+    {
+      entry = fat_cachevictim(fs, &ret);
+      if (entry == NULL)
+        {
+          return ret;
+        }
+
+      entry->ce_sector = sector;
+    }
+
+  entry->ce_age   = ++fs->fs_cacheage;
+  entry->ce_dirty = true;
+  memcpy(entry->ce_buffer, buffer, fs->fs_hwsectorsize);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cacheflush
+ *
+ * Description:
+ *   Write all dirty sectors in the cache to the device.  The sectors remain
+ *   in the cache.
+ *
+ ****************************************************************************/
+
+int fat_cacheflush(FAR struct fat_mountpt_s *fs)
+{
+  FAR struct fat_cacheentry_s *entry;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      entry = &fs->fs_cache[i];
+      if (entry->ce_dirty)
+        {
+          ret = fat_writesector(fs, entry->ce_buffer, entry->ce_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          entry->ce_dirty = false;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachehwread
+ *
+ * Description:
+ *   Called after sectors were read from the device outside of the cache.
+ *   The device does not yet hold the dirty sectors of the cache, so those
+ *   are copied over the data that was read.
+ *
+ ****************************************************************************/
+
+void fat_cachehwread(FAR struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                     off_t sector, unsigned int nsectors)
+{
+  FAR struct fat_cacheentry_s *entry;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      entry = &fs->fs_cache[i];
+      if (entry->ce_dirty && entry->ce_sector >= sector &&
+          entry->ce_sector < sector + (off_t)nsectors)
+        {
+          memcpy(&buffer[(entry->ce_sector - sector) * fs->fs_hwsectorsize],
+                 entry->ce_buffer, fs->fs_hwsectorsize);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cachehwwrite
+ *
+ * Description:
+ *   Called after sectors were written to the device outside of the cache.
+ *   Cached copies of these sectors are replaced with the new data and are
+ *   no longer dirty.
+ *
+ ****************************************************************************/
+
+void fat_cachehwwrite(FAR struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                      off_t sector, unsigned int nsectors)
+{
+  FAR struct fat_cacheentry_s *entry;
+  FAR uint8_t *src;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE_NSECTORS; i++)
+    {
+      entry = &fs->fs_cache[i];
+      if (entry->ce_sector >= sector &&
+          entry->ce_sector < sector + (off_t)nsectors)
+        {
+          src = &buffer[(entry->ce_sector - sector) * fs->fs_hwsectorsize];
+          if (src != entry->ce_buffer)
+            {
+              memcpy(entry->ce_buffer, src, fs->fs_hwsectorsize);
+            }
+
+          entry->ce_dirty = false;
+        }
+    }
+}
+
+#endif /* CONFIG_FAT_SECTORCACHE */
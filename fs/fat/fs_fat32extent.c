@@ -0,0 +1,209 @@
+/****************************************************************************
+ * fs/fat/fs_fat32extent.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/fat.h>
+
+#include "inode/inode.h"
+#include "fs_fat32.h"
+
+#ifdef CONFIG_FAT_EXTENTCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The cluster index of a file position */
+
+#define FILECLUS(fs,pos) \
+  ((uint32_t)(SEC_NSECTORS(fs, pos) / (fs)->fs_fatsecperclus))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_extentcheck
+ *
+ * Description:
+ *   Discard the extents of the file if clusters were removed from any
+ *   cluster chain since they were recorded.
+ *
+ ****************************************************************************/
+
+static void fat_extentcheck(FAR struct fat_mountpt_s *fs,
+                            FAR struct fat_file_s *ff)
+{
+  if (ff->ff_extentgen != fs->fs_chaingen ||
+      (ff->ff_nextents > 0 &&
+       ff->ff_extents[0].fe_cluster != ff->ff_startcluster))
+    {
+      ff->ff_nextents  = 0;
+      ff->ff_extentgen = fs->fs_chaingen;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_extentseek
+ *
+ * Description:
+ *   Find the cluster that holds 'position' in the extents of the file.  If
+ *   the position lies beyond the recorded extents, then the last recorded
+ *   cluster is returned and the caller must follow the cluster chain from
+ *   there.
+ *
+ * Input Parameters:
+ *   fs       - The mountpoint
+ *   ff       - The open file.  It must have a cluster chain.
+ *   position - The file position
+ *   cluster  - Location to return the cluster
+ *
+ * Returned Value:
+ *   The file position of the beginning of the returned cluster.
+ *
+ ****************************************************************************/
+
+off_t fat_extentseek(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
+                     off_t position, FAR int32_t *cluster)
+{
+  FAR struct fat_extent_s *extent;
+  uint32_t fileclus;
+  int low;
+  int high;
+  int mid;
+
+  /* This records at least the first cluster of the file */
+
+  fat_extentadd(fs, ff, 0, ff->ff_startcluster);
+  if (ff->ff_nextents == 0)
+    {
+      *cluster = ff->ff_startcluster;
+      return 0;
+    }
+
+  /* Binary search for the last extent that begins at or before the
+   * cluster index of the position.  The first extent begins at zero.
+   */
+
+  fileclus = FILECLUS(fs, position);
+  low      = 0;
+  high     = ff->ff_nextents - 1;
+
+  while (low < high)
+    {
+      mid = (low + high + 1) / 2;
+      if (ff->ff_extents[mid].fe_fileclus <= fileclus)
+        {
+          low = mid;
+        }
+      else
+        {
+          high = mid - 1;
+        }
+    }
+
+  /* If the position lies beyond the extent, then return the last cluster
+   * of the extent.
+   */
+
+  extent = &ff->ff_extents[low];
+  if (fileclus >= extent->fe_fileclus + extent->fe_count)
+    {
+      fileclus = extent->fe_fileclus + extent->fe_count - 1;
+    }
+
+  *cluster = extent->fe_cluster + (fileclus - extent->fe_fileclus);
+  return (off_t)fileclus * fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+}
+
+/****************************************************************************
+ * Name: fat_extentadd
+ *
+ * Description:
+ *   Record that the cluster index of 'position' in the file maps to
+ *   'cluster'.  Only the clusters that directly follow the recorded ones
+ *   are kept, so the extents always map the beginning of the chain.  A
+ *   cluster that follows the last extent on the media extends it.
+ *
+ *   The first cluster of the file is recorded from ff_startcluster.
+ *
+ ****************************************************************************/
+
+void fat_extentadd(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
+                   off_t position, uint32_t cluster)
+{
+  FAR struct fat_extent_s *extent;
+  uint32_t fileclus;
+
+  fat_extentcheck(fs, ff);
+
+  if (ff->ff_nextents == 0)
+    {
+      /* The first cluster of the file is always known */
+
+      if (ff->ff_startcluster < 2)
+        {
+          return;
+        }
+
+      ff->ff_extents[0].fe_fileclus = 0;
+      ff->ff_extents[0].fe_cluster  = ff->ff_startcluster;
+      ff->ff_extents[0].fe_count    = 1;
+      ff->ff_nextents               = 1;
+    }
+
+  fileclus = FILECLUS(fs, position);
+  extent   = &ff->ff_extents[ff->ff_nextents - 1];
+  if (fileclus != extent->fe_fileclus + extent->fe_count)
+    {
+      return;
+    }
+
+  if (cluster == extent->fe_cluster + extent->fe_count)
+    {
+      extent->fe_count++;
+    }
+  else if (ff->ff_nextents < CONFIG_FAT_EXTENTCACHE_NEXTENTS)
+    {
+      extent++;
+      extent->fe_fileclus = fileclus;
+      extent->fe_cluster  = cluster;
+      extent->fe_count    = 1;
+      ff->ff_nextents++;
+    }
+}
+
+#endif /* CONFIG_FAT_EXTENTCACHE */
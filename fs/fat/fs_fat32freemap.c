@@ -0,0 +1,242 @@
+/****************************************************************************
+ * fs/fat/fs_fat32freemap.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/fat.h>
+
+#include "inode/inode.h"
+#include "fs_fat32.h"
+
+#ifdef CONFIG_FAT_FREEMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FREEMAP_NWORDS(fs)   (((fs)->fs_nclusters + 31) / 32)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_freemapscan
+ *
+ * Description:
+ *   Return the first free cluster in the range [first, last) or zero if
+ *   there is none.
+ *
+ ****************************************************************************/
+
+static uint32_t fat_freemapscan(FAR struct fat_mountpt_s *fs,
+                                uint32_t first, uint32_t last)
+{
+  uint32_t used;
+  uint32_t cluster;
+
+  while (first < last)
+    {
+      /* Treat the clusters before 'first' in this word as used */
+
+      used = fs->fs_freemap[first / 32] |
+             (((uint32_t)1 << (first % 32)) - 1);
+      if (used != UINT32_MAX)
+        {
+          cluster = (first & ~31) + ffsl((long)~used) - 1;
+          return cluster < last ? cluster : 0;
+        }
+
+      first = (first & ~31) + 32;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_freemapbuild
+ *
+ * Description:
+ *   Allocate the free cluster bitmap and fill it from the FAT.  The count
+ *   of free clusters is updated as a side effect.
+ *
+ ****************************************************************************/
+
+int fat_freemapbuild(FAR struct fat_mountpt_s *fs)
+{
+  FAR uint32_t *freemap;
+  uint32_t nfreeclusters = 0;
+  uint32_t cluster;
+  off_t next;
+
+  freemap = (FAR uint32_t *)
+    kmm_zalloc(FREEMAP_NWORDS(fs) * sizeof(uint32_t));
+  if (freemap == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Clusters 0 and 1 and the bits beyond the last cluster are never
+   * free.
+   */
+
+  freemap[0] |= 3;
+  if ((fs->fs_nclusters % 32) != 0)
+    {
+      freemap[fs->fs_nclusters / 32] |=
+        ~(((uint32_t)1 << (fs->fs_nclusters % 32)) - 1);
+    }
+
+  /* Examine every cluster in the FAT */
+
+  for (cluster = 2; cluster < fs->fs_nclusters; cluster++)
+    {
+      next = fat_getcluster(fs, cluster);
+      if (next < 0)
+        {
+          kmm_free(freemap);
+          return (int)next;
+        }
+      else if (next != 0)
+        {
+          freemap[cluster / 32] |= (uint32_t)1 << (cluster % 32);
+        }
+      else
+        {
+          nfreeclusters++;
+        }
+    }
+
+  fs->fs_freemap = freemap;
+
+  if (fs->fs_fsifreecount != nfreeclusters)
+    {
+      fs->fs_fsifreecount = nfreeclusters;
+      if (fs->fs_type == FSTYPE_FAT32)
+        {
+          fs->fs_fsidirty = true;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_freemapfree
+ *
+ * Description:
+ *   Free the free cluster bitmap.
+ *
+ ****************************************************************************/
+
+void fat_freemapfree(FAR struct fat_mountpt_s *fs)
+{
+  if (fs->fs_freemap != NULL)
+    {
+      kmm_free(fs->fs_freemap);
+      fs->fs_freemap = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_freemapfind
+ *
+ * Description:
+ *   Find a free cluster after 'startcluster', wrapping around at the end
+ *   of the volume.  The bitmap is built on first use.
+ *
+ * Returned Value:
+ *   <0: error (-ENOMEM if the bitmap could not be allocated), 0: no free
+ *   cluster, >=2: the free cluster number
+ *
+ ****************************************************************************/
+
+int32_t fat_freemapfind(FAR struct fat_mountpt_s *fs, uint32_t startcluster)
+{
+  uint32_t cluster;
+  int ret;
+
+  if (fs->fs_freemap == NULL)
+    {
+      ret = fat_freemapbuild(fs);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (startcluster < 1 || startcluster >= fs->fs_nclusters)
+    {
+      startcluster = 1;
+    }
+
+  cluster = fat_freemapscan(fs, startcluster + 1, fs->fs_nclusters);
+  if (cluster == 0)
+    {
+      cluster = fat_freemapscan(fs, 2, startcluster + 1);
+    }
+
+  return (int32_t)cluster;
+}
+
+/****************************************************************************
+ * Name: fat_freemapupdate
+ *
+ * Description:
+ *   Track a change of the FAT entry of 'cluster'.  Called by
+ *   fat_putcluster().
+ *
+ ****************************************************************************/
+
+void fat_freemapupdate(FAR struct fat_mountpt_s *fs, uint32_t cluster,
+                       bool inuse)
+{
+  if (fs->fs_freemap != NULL && cluster >= 2 && cluster < fs->fs_nclusters)
+    {
+      if (inuse)
+        {
+          fs->fs_freemap[cluster / 32] |= (uint32_t)1 << (cluster % 32);
+        }
+      else
+        {
+          fs->fs_freemap[cluster / 32] &= ~((uint32_t)1 << (cluster % 32));
+        }
+    }
+}
+
+#endif /* CONFIG_FAT_FREEMAP */
@@ -257,6 +257,83 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_findfreecluster
+ *
+ * Description:
+ *   Search the FAT for a free cluster after 'startcluster', wrapping around
+ *   at the end of the volume.
+ *
+ * Returned Value:
+ *   <0:error, 0: no free cluster, >=2: free cluster number
+ *
+ ****************************************************************************/
+
+static int32_t fat_findfreecluster(struct fat_mountpt_s *fs,
+                                   uint32_t startcluster)
+{
+  off_t    startsector;
+  uint32_t newcluster;
+
+  /* Loop until (1) we discover that there are not free clusters
+   * (return 0), an errors occurs (return -errno), or (3) we find
+   * the next cluster (return the new cluster number).
+   */
+
+  newcluster = startcluster;
+  for (; ; )
+    {
+      /* Examine the next cluster in the FAT */
+
+      newcluster++;
+      if (newcluster >= fs->fs_nclusters)
+        {
+          /* If we hit the end of the available clusters, then
+           * wrap back to the beginning because we might have
+           * started at a non-optimal place.  But don't continue
+           * past the start cluster.
+           */
+
+          newcluster = 2;
+          if (newcluster > startcluster)
+            {
+              /* We are back past the starting cluster, then there
+               * is no free cluster.
+               */
+
+              return 0;
+            }
+        }
+
+      /* We have a candidate cluster.  Check if the cluster number is
+       * mapped to a group of sectors.
+       */
+
+      startsector = fat_getcluster(fs, newcluster);
+      if (startsector == 0)
+        {
+          /* Found have found a free cluster */
+
+          return newcluster;
+        }
+      else if (startsector < 0)
+        {
+          /* Some error occurred, return the error number */
+
+          return startsector;
+        }
+
+      /* We wrap all the back to the starting cluster?  If so, then
+       * there are no free clusters.
+       */
+
+      if (newcluster == startcluster)
+        {
+          return 0;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -525,6 +602,16 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Allocate the sector cache */
+
+  ret = fat_cacheinitialize(fs);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+#endif
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -653,6 +740,9 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#ifdef CONFIG_FAT_SECTORCACHE
+  fat_cacheuninitialize(fs);
+#endif
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = 0;
 
@@ -727,6 +817,9 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
                                                        sector, nsectors);
           if (nsectorsread == nsectors)
             {
+#ifdef CONFIG_FAT_SECTORCACHE
+              fat_cachehwread(fs, buffer, sector, nsectors);
+#endif
               ret = OK;
             }
           else if (nsectorsread < 0)
@@ -761,6 +854,9 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
 
           if (nsectorswritten == nsectors)
             {
+#ifdef CONFIG_FAT_SECTORCACHE
+              fat_cachehwwrite(fs, buffer, sector, nsectors);
+#endif
               ret = OK;
             }
           else if (nsectorswritten < 0)
@@ -773,6 +869,49 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_writesector
+ *
+ * Description:
+ *   Write one buffered sector to the device.  A sector of the FAT region is
+ *   also written to the other copies of the FAT.
+ *
+ ****************************************************************************/
+
+int fat_writesector(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector)
+{
+  int ret;
+  int i;
+
+  /* Write the sector */
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: fat_cluster2sector
  *
@@ -1094,6 +1233,9 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
       /* Mark the modified sector as "dirty" and return success */
 
       fs->fs_dirty = true;
+#ifdef CONFIG_FAT_FREEMAP
+      fat_freemapupdate(fs, clusterno, nextcluster != 0);
+#endif
       return OK;
     }
 
@@ -1113,6 +1255,12 @@ int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
   int32_t nextcluster;
   int    ret;
 
+#ifdef CONFIG_FAT_EXTENTCACHE
+  /* The extents recorded for open files may no longer be valid */
+
+  fs->fs_chaingen++;
+#endif
+
   /* Loop while there are clusters in the chain */
 
   while (cluster >= 2 && cluster < fs->fs_nclusters)
@@ -1166,7 +1314,7 @@ int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
 int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
 {
   off_t    startsector;
-  uint32_t newcluster;
+  int32_t  newcluster;
   uint32_t startcluster;
   int      ret;
 
@@ -1217,66 +1365,29 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
-  /* Loop until (1) we discover that there are not free clusters
-   * (return 0), an errors occurs (return -errno), or (3) we find
-   * the next cluster (return the new cluster number).
+#ifdef CONFIG_FAT_FREEMAP
+  /* Look for a free cluster in the free cluster bitmap.  Search the FAT
+   * only if there is not enough memory for the bitmap.
    */
 
-  newcluster = startcluster;
-  for (; ; )
+  newcluster = fat_freemapfind(fs, startcluster);
+  if (newcluster == -ENOMEM)
     {
-      /* Examine the next cluster in the FAT */
-
-      newcluster++;
-      if (newcluster >= fs->fs_nclusters)
-        {
-          /* If we hit the end of the available clusters, then
-           * wrap back to the beginning because we might have
-           * started at a non-optimal place.  But don't continue
-           * past the start cluster.
-           */
-
-          newcluster = 2;
-          if (newcluster > startcluster)
-            {
-              /* We are back past the starting cluster, then there
-               * is no free cluster.
-               */
-
-              return 0;
-            }
-        }
-
-      /* We have a candidate cluster.  Check if the cluster number is
-       * mapped to a group of sectors.
-       */
-
-      startsector = fat_getcluster(fs, newcluster);
-      if (startsector == 0)
-        {
-          /* Found have found a free cluster break out */
-
-          break;
-        }
-      else if (startsector < 0)
-        {
-          /* Some error occurred, return the error number */
-
-          return startsector;
-        }
+      newcluster = fat_findfreecluster(fs, startcluster);
+    }
+#else
+  newcluster = fat_findfreecluster(fs, startcluster);
+#endif
 
-      /* We wrap all the back to the starting cluster?  If so, then
-       * there are no free clusters.
-       */
+  if (newcluster <= 0)
+    {
+      /* An error occurred or there is no free cluster */
 
-      if (newcluster == startcluster)
-        {
-          return 0;
-        }
+      return newcluster;
     }
 
-  /* We get here only if we break out with an available cluster
-   * number in 'newcluster'  Now mark that cluster as in-use.
+  /* We get here only if we found an available cluster number in
+   * 'newcluster'  Now mark that cluster as in-use.
    */
 
   ret = fat_putcluster(fs, newcluster, 0x0fffffff);
@@ -1753,7 +1864,8 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
  * Name: fat_fscacheflush
  *
  * Description:
- *   Flush any dirty sector if fs_buffer as necessary
+ *   Flush any dirty sector if fs_buffer as necessary.  All dirty sectors in
+ *   the sector cache are written back as well.
  *
  ****************************************************************************/
 
@@ -1769,38 +1881,24 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
     {
       /* Write the dirty sector */
 
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_writesector(fs, fs->fs_buffer, fs->fs_currentsector);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Then write back the sectors that were modified earlier */
+
+  return fat_cacheflush(fs);
+#else
   return OK;
+#endif
 }
 
 /****************************************************************************
@@ -1823,6 +1921,28 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 
   if (fs->fs_currentsector != sector)
     {
+#ifdef CONFIG_FAT_SECTORCACHE
+      /* We will need to read the new sector.  First, move the buffered
+       * sector into the sector cache if it is dirty.  It will be written
+       * back when it is evicted from the cache or when the cache is
+       * flushed.
+       */
+
+      if (fs->fs_dirty)
+        {
+          ret = fat_cachewrite(fs, fs->fs_buffer, fs->fs_currentsector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          fs->fs_dirty = false;
+        }
+
+      /* Then get the specified sector from the sector cache */
+
+      ret = fat_cacheread(fs, fs->fs_buffer, sector);
+#else
       /* We will need to read the new sector.  First, flush the cached
        * sector if it is dirty.
        */
@@ -1836,6 +1956,7 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
       /* Then read the specified sector into the cache */
 
       ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
+#endif
       if (ret < 0)
         {
           return ret;
@@ -1918,7 +2039,11 @@ int fat_ffcacheread(struct fat_mountpt_s *fs, struct fat_file_s *ff,
 
       /* Then read the specified sector into the cache */
 
+#ifdef CONFIG_FAT_SECTORCACHE
+      ret = fat_cacheread(fs, ff->ff_buffer, sector);
+#else
       ret = fat_hwread(fs, ff->ff_buffer, sector, 1);
+#endif
       if (ret < 0)
         {
           return ret;
@@ -2038,6 +2163,16 @@ int fat_nfreeclusters(struct fat_mountpt_s *fs, off_t *pfreeclusters)
       return OK;
     }
 
+#ifdef CONFIG_FAT_FREEMAP
+  /* Building the free cluster bitmap also counts the free clusters */
+
+  if (fs->fs_freemap == NULL && fat_freemapbuild(fs) == OK)
+    {
+      *pfreeclusters = fs->fs_fsifreecount;
+      return OK;
+    }
+#endif
+
   /* Otherwise, we will have to count the number of free clusters */
 
   nfreeclusters = 0;
@@ -80,6 +80,10 @@ int file_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Drop the epoll registrations of the file */
+
+      epoll_release(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
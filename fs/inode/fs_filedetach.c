@@ -88,22 +88,23 @@ int file_detach(int fd, FAR struct file *filep)
 
   DEBUGASSERT(filep != NULL);
 
+  /* Get the thread-specific file list.  It should never be NULL in this
+   * context.
+   */
+
+  list = nxsched_get_files();
+  DEBUGASSERT(list != NULL);
+
   /* Verify the file descriptor range */
 
-  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS)
+  parent = files_fget(list, fd);
+  if (parent == NULL)
     {
       /* Not a file descriptor (might be a socket descriptor) */
 
       return -EBADF;
     }
 
-  /* Get the thread-specific file list.  It should never be NULL in this
-   * context.
-   */
-
-  list = nxsched_get_files();
-  DEBUGASSERT(list != NULL);
-
   /* If the file was properly opened, there should be an inode assigned */
 
   ret = _files_semtake(list);
@@ -114,7 +115,6 @@ int file_detach(int fd, FAR struct file *filep)
       return ret;
     }
 
-  parent = &list->fl_files[fd];
   if (parent->f_inode == NULL)
     {
       /* File is not open */
@@ -123,6 +123,10 @@ int file_detach(int fd, FAR struct file *filep)
       return -EBADF;
     }
 
+  /* The registrations refer to the descriptor, which goes away */
+
+  epoll_release(parent);
+
   /* Duplicate the 'struct file' content into the user-provided file
    * structure.
    */
@@ -142,6 +146,9 @@ int file_detach(int fd, FAR struct file *filep)
   parent->f_inode  = NULL;
   parent->f_priv   = NULL;
 
+  list->fl_used[fd / FILELIST_CHUNK] &=
+    ~((uint32_t)1 << (fd % FILELIST_CHUNK));
+
   _files_semgive(list);
   return OK;
 }
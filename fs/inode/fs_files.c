@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <string.h>
+#include <strings.h>
 #include <assert.h>
 #include <sched.h>
 #include <errno.h>
@@ -33,6 +34,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
@@ -55,6 +57,86 @@ static int _files_semtake(FAR struct filelist *list)
 
 #define _files_semgive(list) nxsem_post(&list->fl_sem)
 
+/****************************************************************************
+ * Name: _files_setused and _files_clrused
+ *
+ * Description:
+ *   Mark a file descriptor as used or as free in the bitmap of the list.
+ *
+ ****************************************************************************/
+
+#define _files_setused(list,fd) \
+  ((list)->fl_used[(fd) / FILELIST_CHUNK] |= \
+   (uint32_t)1 << ((fd) % FILELIST_CHUNK))
+
+#define _files_clrused(list,fd) \
+  ((list)->fl_used[(fd) / FILELIST_CHUNK] &= \
+   ~((uint32_t)1 << ((fd) % FILELIST_CHUNK)))
+
+/****************************************************************************
+ * Name: _files_extend
+ *
+ * Description:
+ *   Allocate a chunk of the list if it has not been allocated yet.
+ *
+ * Assumptions:
+ *   Caller holds the list semaphore.
+ *
+ ****************************************************************************/
+
+static int _files_extend(FAR struct filelist *list, int chunk)
+{
+  FAR struct file *files;
+
+  if (list->fl_files[chunk] != NULL)
+    {
+      return OK;
+    }
+
+  files = (FAR struct file *)
+    kmm_zalloc(sizeof(struct file) * FILELIST_CHUNK);
+  if (files == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* files_fget() does not take the list semaphore.  The cleared chunk must
+   * be visible before the pointer to it.
+   */
+
+#ifdef CONFIG_SPINLOCK
+  SP_DMB();
+#endif
+  list->fl_files[chunk] = files;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: _files_fd
+ *
+ * Description:
+ *   Return the file descriptor of a file structure of the list or -1 if the
+ *   file structure is not part of the list.
+ *
+ ****************************************************************************/
+
+static int _files_fd(FAR struct filelist *list, FAR struct file *filep)
+{
+  FAR struct file *files;
+  int chunk;
+
+  for (chunk = 0; chunk < FILELIST_NCHUNKS; chunk++)
+    {
+      files = list->fl_files[chunk];
+      if (files != NULL && filep >= files && filep < files + FILELIST_CHUNK)
+        {
+          return chunk * FILELIST_CHUNK + (filep - files);
+        }
+    }
+
+  return -1;
+}
+
 /****************************************************************************
  * Name: _files_close
  *
@@ -76,6 +158,10 @@ static int _files_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Drop the epoll registrations of the file */
+
+      epoll_release(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
@@ -141,6 +227,8 @@ void files_initlist(FAR struct filelist *list)
 
 void files_releaselist(FAR struct filelist *list)
 {
+  FAR struct file *files;
+  int chunk;
   int i;
 
   DEBUGASSERT(list);
@@ -150,9 +238,20 @@ void files_releaselist(FAR struct filelist *list)
    * because there should not be any references in this context.
    */
 
-  for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  for (chunk = 0; chunk < FILELIST_NCHUNKS; chunk++)
     {
-      _files_close(&list->fl_files[i]);
+      files = list->fl_files[chunk];
+      if (files != NULL)
+        {
+          for (i = 0; i < FILELIST_CHUNK; i++)
+            {
+              _files_close(&files[i]);
+            }
+
+          list->fl_files[chunk] = NULL;
+          list->fl_used[chunk]  = 0;
+          kmm_free(files);
+        }
     }
 
   /* Destroy the semaphore */
@@ -160,6 +259,66 @@ void files_releaselist(FAR struct filelist *list)
   nxsem_destroy(&list->fl_sem);
 }
 
+/****************************************************************************
+ * Name: files_fget
+ *
+ * Description:
+ *   Return the file structure of a file descriptor in the list.  The file
+ *   may or may not be open.  The list semaphore is not needed.
+ *
+ ****************************************************************************/
+
+FAR struct file *files_fget(FAR struct filelist *list, int fd)
+{
+  FAR struct file *files;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return NULL;
+    }
+
+  files = list->fl_files[fd / FILELIST_CHUNK];
+  if (files == NULL)
+    {
+      return NULL;
+    }
+
+  return &files[fd % FILELIST_CHUNK];
+}
+
+/****************************************************************************
+ * Name: files_extend
+ *
+ * Description:
+ *   Make sure that the chunk of the list that holds the file descriptor
+ *   'fd' is allocated.
+ *
+ ****************************************************************************/
+
+int files_extend(FAR struct filelist *list, int fd)
+{
+  int ret;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return -EBADF;
+    }
+
+  if (list->fl_files[fd / FILELIST_CHUNK] != NULL)
+    {
+      return OK;
+    }
+
+  ret = _files_semtake(list);
+  if (ret >= 0)
+    {
+      ret = _files_extend(list, fd / FILELIST_CHUNK);
+      _files_semgive(list);
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: file_dup2
  *
@@ -181,6 +340,7 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 {
   FAR struct filelist *list;
   FAR struct inode *inode;
+  int fd2 = -1;
   int ret;
 
   if (filep1 == NULL || filep1->f_inode == NULL || filep2 == NULL)
@@ -206,6 +366,12 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 
           return ret;
         }
+
+      /* Is filep2 a descriptor of the list?  Then its bit in the bitmap
+       * must follow its state.
+       */
+
+      fd2 = _files_fd(list, filep2);
     }
 
   /* If there is already an inode contained in the new file structure,
@@ -264,6 +430,11 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
         }
     }
 
+  if (fd2 >= 0)
+    {
+      _files_setused(list, fd2);
+    }
+
   if (list != NULL)
     {
       _files_semgive(list);
@@ -281,6 +452,11 @@ errout_with_inode:
   filep2->f_inode  = NULL;
 
 errout_with_sem:
+  if (fd2 >= 0 && filep2->f_inode == NULL)
+    {
+      _files_clrused(list, fd2);
+    }
+
   if (list != NULL)
     {
       _files_semgive(list);
@@ -296,13 +472,19 @@ errout_with_sem:
  *   Allocate a struct files instance and associate it with an inode
  *   instance.  Returns the file descriptor == index into the files array.
  *
+ *   The lowest free descriptor is found in the bitmap of the list, one
+ *   chunk at a time.  The chunk is allocated if needed.
+ *
  ****************************************************************************/
 
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 {
   FAR struct filelist *list;
+  FAR struct file *filep;
+  uint32_t used;
+  int chunk;
   int ret;
-  int i;
+  int fd;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
@@ -317,17 +499,52 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
       return ret;
     }
 
-  for (i = minfd; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  for (chunk = minfd / FILELIST_CHUNK; chunk < FILELIST_NCHUNKS; chunk++)
     {
-      if (!list->fl_files[i].f_inode)
+      used = list->fl_used[chunk];
+
+      /* Treat the descriptors below minfd and beyond the end of the list
+       * as used.
+       */
+
+      if (chunk == minfd / FILELIST_CHUNK)
         {
-          list->fl_files[i].f_oflags = oflags;
-          list->fl_files[i].f_pos    = pos;
-          list->fl_files[i].f_inode  = inode;
-          list->fl_files[i].f_priv   = NULL;
-          _files_semgive(list);
-          return i;
+          used |= ((uint32_t)1 << (minfd % FILELIST_CHUNK)) - 1;
         }
+
+#if FILELIST_CHUNK < 32
+      used |= ~(((uint32_t)1 << FILELIST_CHUNK) - 1);
+#endif
+
+#if (CONFIG_NFILE_DESCRIPTORS % FILELIST_CHUNK) != 0
+      if (chunk == FILELIST_NCHUNKS - 1)
+        {
+          used |= ~(((uint32_t)1 <<
+                     (CONFIG_NFILE_DESCRIPTORS % FILELIST_CHUNK)) - 1);
+        }
+#endif
+
+      if (used == UINT32_MAX)
+        {
+          continue;
+        }
+
+      if (_files_extend(list, chunk) < 0)
+        {
+          break;
+        }
+
+      fd    = chunk * FILELIST_CHUNK + ffsl((long)~used) - 1;
+      filep = &list->fl_files[chunk][fd % FILELIST_CHUNK];
+      DEBUGASSERT(filep->f_inode == NULL);
+
+      _files_setused(list, fd);
+      filep->f_oflags = oflags;
+      filep->f_pos    = pos;
+      filep->f_inode  = inode;
+      filep->f_priv   = NULL;
+      _files_semgive(list);
+      return fd;
     }
 
   _files_semgive(list);
@@ -349,6 +566,7 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 int files_close(int fd)
 {
   FAR struct filelist *list;
+  FAR struct file     *filep;
   int                  ret;
 
   /* Get the thread-specific file list.  It should never be NULL in this
@@ -360,8 +578,8 @@ int files_close(int fd)
 
   /* If the file was properly opened, there should be an inode assigned */
 
-  if (fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS ||
-      !list->fl_files[fd].f_inode)
+  filep = files_fget(list, fd);
+  if (filep == NULL || !filep->f_inode)
     {
       return -EBADF;
     }
@@ -371,7 +589,8 @@ int files_close(int fd)
   ret = _files_semtake(list);
   if (ret >= 0)
     {
-      ret = _files_close(&list->fl_files[fd]);
+      ret = _files_close(filep);
+      _files_clrused(list, fd);
       _files_semgive(list);
     }
 
@@ -390,19 +609,22 @@ int files_close(int fd)
 void files_release(int fd)
 {
   FAR struct filelist *list;
+  FAR struct file *filep;
   int ret;
 
   list = nxsched_get_files();
   DEBUGASSERT(list != NULL);
 
-  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS)
+  filep = files_fget(list, fd);
+  if (filep != NULL)
     {
       ret = _files_semtake(list);
       if (ret >= 0)
         {
-          list->fl_files[fd].f_oflags  = 0;
-          list->fl_files[fd].f_pos     = 0;
-          list->fl_files[fd].f_inode = NULL;
+          filep->f_oflags  = 0;
+          filep->f_pos     = 0;
+          filep->f_inode   = NULL;
+          _files_clrused(list, fd);
           _files_semgive(list);
         }
     }
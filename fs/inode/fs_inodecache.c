@@ -0,0 +1,284 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* 32-bit FNV-1a hash of the path */
+
+#define INODE_HASH_BASIS  2166136261u
+#define INODE_HASH_PRIME  16777619u
+
+#define INODE_HASH(h,c)   (((h) ^ (uint8_t)(c)) * INODE_HASH_PRIME)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached inode_search() result.  The path is the part of the search
+ * path that was consumed, without the leading '/'.  If the node is a
+ * mountpoint, the rest of the search path is the relative path into the
+ * mountpoint.
+ */
+
+struct inode_cache_s
+{
+  uint32_t gen;                  /* Valid if equal to g_inode_cachegen */
+  uint32_t hash;                 /* Hash of the path */
+  FAR struct inode *node;        /* The inode found */
+  FAR struct inode *peer;        /* Node to the "left" of the inode */
+  FAR struct inode *parent;      /* Node "above" the inode */
+  uint8_t len;                   /* Length of the path */
+  char path[CONFIG_FS_INODE_CACHE_PATHLEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The cache is a direct mapped hash table.  It is protected by the inode
+ * semaphore, like the inode tree itself.
+ */
+
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODE_CACHE_NENTRIES];
+
+/* Bumped to invalidate all entries at once */
+
+static uint32_t g_inode_cachegen = 1;
+
+static struct inode_cachestat_s g_inode_cachestat;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_entry
+ ****************************************************************************/
+
+static inline FAR struct inode_cache_s *inode_cache_entry(uint32_t hash)
+{
+  return &g_inode_cache[hash % CONFIG_FS_INODE_CACHE_NENTRIES];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_find
+ *
+ * Description:
+ *   Look up 'desc->path' in the cache.  The path and each of its leading
+ *   directories are looked up in a single pass so that the mountpoint of
+ *   the path is also found.
+ *
+ * Returned Value:
+ *   true if the search result was found in the cache and returned in
+ *   'desc'.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+bool inode_cache_find(FAR struct inode_search_s *desc)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *name = desc->path;
+  FAR const char *relpath;
+  uint32_t hash = INODE_HASH_BASIS;
+  int len;
+
+  while (*name == '/')
+    {
+      name++;
+    }
+
+  for (len = 0; len < CONFIG_FS_INODE_CACHE_PATHLEN; len++)
+    {
+      if (name[len] != '/' && name[len] != '\0')
+        {
+          hash = INODE_HASH(hash, name[len]);
+          continue;
+        }
+
+      /* At the end of a path segment.  An empty segment cannot be in the
+       * cache.
+       */
+
+      if (len == 0 || name[len - 1] == '/')
+        {
+          break;
+        }
+
+      entry = inode_cache_entry(hash);
+      if (entry->gen == g_inode_cachegen && entry->hash == hash &&
+          entry->len == len && memcmp(entry->path, name, len) == 0)
+        {
+          relpath = &name[len];
+          while (*relpath == '/')
+            {
+              relpath++;
+            }
+
+          /* A leading directory is only the result if it is a
+           * mountpoint.
+           */
+
+          if (*relpath == '\0' || INODE_IS_MOUNTPT(entry->node))
+            {
+              desc->path    = relpath;
+              desc->node    = entry->node;
+              desc->peer    = entry->peer;
+              desc->parent  = entry->parent;
+              desc->relpath = relpath;
+
+              g_inode_cachestat.hits++;
+              return true;
+            }
+        }
+
+      if (name[len] == '\0')
+        {
+          break;
+        }
+
+      hash = INODE_HASH(hash, '/');
+    }
+
+  g_inode_cachestat.misses++;
+  return false;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Add the result of a successful search to the cache.  'name' is the
+ *   search path without the leading '/'.  Paths that are too long for the
+ *   cache are not added.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const char *name, FAR struct inode_search_s *desc)
+{
+  FAR struct inode_cache_s *entry;
+  uint32_t hash = INODE_HASH_BASIS;
+  int len;
+  int i;
+
+  DEBUGASSERT(desc->node != NULL && desc->relpath != NULL);
+
+  /* The consumed part of the path, without the trailing '/' */
+
+  len = desc->relpath - name;
+  while (len > 0 && name[len - 1] == '/')
+    {
+      len--;
+    }
+
+  if (len <= 0 || len >= CONFIG_FS_INODE_CACHE_PATHLEN)
+    {
+      return;
+    }
+
+  for (i = 0; i < len; i++)
+    {
+      if (name[i] == '/' && name[i + 1] == '/')
+        {
+          return;
+        }
+
+      hash = INODE_HASH(hash, name[i]);
+    }
+
+  entry         = inode_cache_entry(hash);
+  entry->gen    = g_inode_cachegen;
+  entry->hash   = hash;
+  entry->node   = desc->node;
+  entry->peer   = desc->peer;
+  entry->parent = desc->parent;
+  entry->len    = len;
+  memcpy(entry->path, name, len);
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Invalidate all cache entries.  This must be called whenever the inode
+ *   tree changes or whenever an inode becomes or stops being a mountpoint.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  if (++g_inode_cachegen == 0)
+    {
+      /* The generation wrapped around.  Old entries could become valid
+       * again.
+       */
+
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cachegen = 1;
+    }
+
+  g_inode_cachestat.invalidations++;
+}
+
+/****************************************************************************
+ * Name: inode_cache_stat
+ *
+ * Description:
+ *   Return the statistics of the cache.
+ *
+ ****************************************************************************/
+
+void inode_cache_stat(FAR struct inode_cachestat_s *stat)
+{
+  memcpy(stat, &g_inode_cachestat, sizeof(struct inode_cachestat_s));
+}
+
+#endif /* CONFIG_FS_INODE_CACHE */
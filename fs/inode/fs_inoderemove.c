@@ -117,6 +117,10 @@ FAR struct inode *inode_unlink(FAR const char *path)
         }
 
       node->i_peer = NULL;
+
+      /* Cached search results may refer to the old tree */
+
+      inode_cache_invalidate();
     }
 
   RELEASE_SEARCH(&desc);
@@ -135,6 +135,10 @@ static void inode_insert(FAR struct inode *node,
       node->i_peer = g_root_inode;
       g_root_inode = node;
     }
+
+  /* Cached search results may refer to the old tree */
+
+  inode_cache_invalidate();
 }
 
 /****************************************************************************
@@ -241,6 +241,10 @@ static int _inode_search(FAR struct inode_search_s *desc)
   FAR struct inode *left    = NULL;
   FAR struct inode *above   = NULL;
   FAR const char   *relpath = NULL;
+#ifdef CONFIG_FS_INODE_CACHE
+  FAR const char   *start;
+  bool cacheable = true;
+#endif
   int ret = -ENOENT;
 
   /* Get the search path, skipping over the leading '/'.  The leading '/' is
@@ -273,6 +277,17 @@ static int _inode_search(FAR struct inode_search_s *desc)
       return -ENOSYS;
     }
 
+#ifdef CONFIG_FS_INODE_CACHE
+  /* Try the path lookup cache before walking the tree */
+
+  if (inode_cache_find(desc))
+    {
+      return OK;
+    }
+
+  start = name;
+#endif
+
   /* Traverse the pseudo file system node tree until either (1) all nodes
    * have been examined without finding the matching node, or (2) the
    * matching node is found.
@@ -344,6 +359,12 @@ static int _inode_search(FAR struct inode_search_s *desc)
                 {
                   int status;
 
+#ifdef CONFIG_FS_INODE_CACHE
+                  /* The result depends on the link target */
+
+                  cacheable = false;
+#endif
+
                   /* If this intermediate inode in the is a soft link, then
                    * (1) get the name of the full path of the soft link, (2)
                    * recursively look-up the inode referenced by the soft
@@ -428,6 +449,14 @@ static int _inode_search(FAR struct inode_search_s *desc)
   desc->peer    = left;
   desc->parent  = above;
   desc->relpath = relpath;
+
+#ifdef CONFIG_FS_INODE_CACHE
+  if (ret >= 0 && cacheable)
+    {
+      inode_cache_add(start, desc);
+    }
+#endif
+
   return ret;
 }
 
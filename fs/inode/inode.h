@@ -136,6 +136,17 @@ typedef int (*foreach_inode_t)(FAR struct inode *node,
                                FAR char dirpath[PATH_MAX],
                                FAR void *arg);
 
+#ifdef CONFIG_FS_INODE_CACHE
+/* Statistics of the path lookup cache */
+
+struct inode_cachestat_s
+{
+  uint32_t hits;             /* Searches that were found in the cache */
+  uint32_t misses;           /* Searches that walked the inode tree */
+  uint32_t invalidations;    /* Number of times the cache was flushed */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -222,6 +233,63 @@ int inode_checkflags(FAR struct inode *inode, int oflags);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_find
+ *
+ * Description:
+ *   Look up the result of inode_search() for 'desc->path' in the path
+ *   lookup cache.  On success, the result is returned in 'desc' and true
+ *   is returned.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+bool inode_cache_find(FAR struct inode_search_s *desc);
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Add the result of a successful search to the path lookup cache.  'name'
+ *   is the search path without the leading '/'.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const char *name, FAR struct inode_search_s *desc);
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Flush the path lookup cache.  This must be called when the inode tree
+ *   is modified and when an inode becomes or stops being a mountpoint.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void);
+
+/****************************************************************************
+ * Name: inode_cache_stat
+ *
+ * Description:
+ *   Return the statistics of the path lookup cache.
+ *
+ ****************************************************************************/
+
+void inode_cache_stat(FAR struct inode_cachestat_s *stat);
+#else
+#  define inode_cache_invalidate()
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
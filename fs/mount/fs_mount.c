@@ -453,6 +453,10 @@ int nx_mount(FAR const char *source, FAR const char *target,
   mountpt_inode->i_mode    = mode;
 #endif
   mountpt_inode->i_private = fshandle;
+
+  /* Paths below the inode are now resolved to the mountpoint */
+
+  inode_cache_invalidate();
   inode_semgive();
 
   /* We can release our reference to the blkdrver_inode, if the filesystem
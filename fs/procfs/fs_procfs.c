@@ -65,6 +65,8 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations lockstat_operations;
+extern const struct procfs_operations inodecache_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations iobinfo_operations;
 extern const struct procfs_operations module_operations;
@@ -112,6 +114,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SPINLOCK_STATS)
+  { "lockstat",      &lockstat_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
 #endif
@@ -136,6 +142,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/usage",      &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_FS_INODE_CACHE
+  { "fs/inodecache", &inodecache_operations,      PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_FS_SMARTFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
   { "fs/smartfs**",  &smartfs_procfsoperations,   PROCFS_UNKOWN_TYPE },
 #endif
@@ -151,6 +151,9 @@ static FAR const char *g_iob_user_names[] =
 #ifdef CONFIG_NET_IPFORWARD
   "ipforward",
 #endif
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  "netdev",
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   "rad802154",
 #endif
@@ -274,7 +277,11 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
                             size_t buflen)
 {
   FAR struct iobinfo_file_s *iobfile;
-  FAR struct iob_userstats_s *userstats;
+  struct iob_userstats_s userstats;
+#if defined(CONFIG_SMP) || defined(CONFIG_IOB_PERCPU_CACHE)
+  struct iob_cpustats_s cpustats;
+  int cpu;
+#endif
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -322,12 +329,12 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
           buffer    += copysize;
           buflen    -= copysize;
 
-          userstats  = iob_getuserstats(i);
+          iob_getuserstats(i, &userstats);
           linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
                                 "%-16s%16lu%16lu\n",
                                 g_iob_user_names[i],
-                                (unsigned long)userstats->totalconsumed,
-                                (unsigned long)userstats->totalproduced);
+                                (unsigned long)userstats.totalconsumed,
+                                (unsigned long)userstats.totalproduced);
 
           copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                      &offset);
@@ -340,18 +347,60 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       buffer    += copysize;
       buflen    -= copysize;
 
-      userstats  = iob_getuserstats(IOBUSER_GLOBAL);
+      iob_getuserstats(IOBUSER_GLOBAL, &userstats);
       linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
                             "\n%-16s%16lu%16lu\n",
                             g_iob_user_names[IOBUSER_GLOBAL],
-                            (unsigned long)userstats->totalconsumed,
-                            (unsigned long)userstats->totalproduced);
+                            (unsigned long)userstats.totalconsumed,
+                            (unsigned long)userstats.totalproduced);
 
       copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                  &offset);
       totalsize += copysize;
     }
 
+#if defined(CONFIG_SMP) || defined(CONFIG_IOB_PERCPU_CACHE)
+  /* Then the per-CPU statistics */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                            "\n%-4s%11s%11s%11s%11s%11s%11s\n",
+                            "CPU", "CONSUMED", "PRODUCED", "CACHED",
+                            "HITS", "REFILLS", "DRAINS");
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (cpu = 0; iob_getcpustats(cpu, &cpustats) >= 0; cpu++)
+    {
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                                "%-4d%11lu%11lu%11lu%11lu%11lu%11lu\n",
+                                cpu,
+                                (unsigned long)cpustats.totalconsumed,
+                                (unsigned long)cpustats.totalproduced,
+                                (unsigned long)cpustats.cached,
+                                (unsigned long)cpustats.hits,
+                                (unsigned long)cpustats.refills,
+                                (unsigned long)cpustats.drains);
+
+          copysize   = procfs_memcpy(iobfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -99,6 +99,9 @@ enum proc_node_e
   PROC_CRITMON,                       /* Critical section monitor */
 #endif
   PROC_STACK,                         /* Task stack info */
+#ifdef CONFIG_MM_HEAP_PROFILE
+  PROC_HEAP,                          /* Task heap usage */
+#endif
   PROC_GROUP,                         /* Group directory */
   PROC_GROUP_STATUS,                  /* Task group status */
   PROC_GROUP_FD                       /* Group file descriptors */
@@ -186,6 +189,11 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
+#ifdef CONFIG_MM_HEAP_PROFILE
+static ssize_t proc_heap(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_groupstatus(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
@@ -284,6 +292,13 @@ static const struct proc_node_s g_stack =
   "stack",        "stack",   (uint8_t)PROC_STACK,        DTYPE_FILE        /* Task stack info */
 };
 
+#ifdef CONFIG_MM_HEAP_PROFILE
+static const struct proc_node_s g_heap =
+{
+  "heap",         "heap",    (uint8_t)PROC_HEAP,         DTYPE_FILE        /* Task heap usage */
+};
+#endif
+
 static const struct proc_node_s g_group =
 {
   "group",        "group",   (uint8_t)PROC_GROUP,        DTYPE_DIRECTORY   /* Group directory */
@@ -320,6 +335,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
   &g_critmon,      /* Critical section Monitor */
 #endif
   &g_stack,        /* Task stack info */
+#ifdef CONFIG_MM_HEAP_PROFILE
+  &g_heap,         /* Task heap usage */
+#endif
   &g_group,        /* Group directory */
   &g_groupstatus,  /* Task group status */
   &g_groupfd       /* Group file descriptors */
@@ -343,6 +361,9 @@ static const struct proc_node_s * const g_level0info[] =
   &g_critmon,      /* Critical section monitor */
 #endif
   &g_stack,        /* Task stack info */
+#ifdef CONFIG_MM_HEAP_PROFILE
+  &g_heap,         /* Task heap usage */
+#endif
   &g_group,        /* Group directory */
 };
 #define PROC_NLEVEL0NODES (sizeof(g_level0info)/sizeof(FAR const struct proc_node_s * const))
@@ -922,6 +943,61 @@ static ssize_t proc_stack(FAR struct proc_file_s *procfile,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: proc_heap
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+static ssize_t proc_heap(FAR struct proc_file_s *procfile,
+                         FAR struct tcb_s *tcb, FAR char *buffer,
+                         size_t buflen, off_t offset)
+{
+  FAR const char *label[4];
+  unsigned long value[4];
+  size_t remaining;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  irqstate_t flags;
+  int i;
+
+  remaining = buflen;
+  totalsize = 0;
+
+  /* Take a consistent snapshot of the totals */
+
+  flags    = enter_critical_section();
+  label[0] = "Bytes:";
+  value[0] = (unsigned long)tcb->heap_bytes;
+  label[1] = "PeakBytes:";
+  value[1] = (unsigned long)tcb->heap_peak;
+  label[2] = "Chunks:";
+  value[2] = (unsigned long)(tcb->heap_allocs - tcb->heap_frees);
+  label[3] = "Allocs:";
+  value[3] = (unsigned long)tcb->heap_allocs;
+  leave_critical_section(flags);
+
+  for (i = 0; i < 4; i++)
+    {
+      linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                            label[i], value[i]);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                 remaining, &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      remaining -= copysize;
+
+      if (totalsize >= buflen)
+        {
+          break;
+        }
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_groupstatus
  ****************************************************************************/
@@ -1103,13 +1179,12 @@ static ssize_t proc_groupfd(FAR struct proc_file_s *procfile,
 
   /* Examine each open file descriptor */
 
-  for (i = 0, file = group->tg_filelist.fl_files;
-       i < CONFIG_NFILE_DESCRIPTORS;
-       i++, file++)
+  for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++)
     {
       /* Is there an inode associated with the file descriptor? */
 
-      if (file->f_inode)
+      file = files_fget(&group->tg_filelist, i);
+      if (file != NULL && file->f_inode)
         {
           linesize   = snprintf(procfile->line, STATUS_LINELEN,
                                 "%3d %8ld %04x\n", i, (long)file->f_pos,
@@ -1463,6 +1538,12 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 
+#ifdef CONFIG_MM_HEAP_PROFILE
+    case PROC_HEAP: /* Task heap usage */
+      ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
+
     case PROC_GROUP_STATUS: /* Task group status */
       ret = proc_groupstatus(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
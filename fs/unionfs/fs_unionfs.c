@@ -2847,6 +2847,7 @@ int unionfs_mount(FAR const char *fspath1, FAR const char *prefix1,
   /* Populate the inode with driver specific information. */
 
   INODE_SET_MOUNTPT(mpinode);
+  inode_cache_invalidate();
 
   mpinode->u.i_mops  = &unionfs_operations;
 #ifdef CONFIG_FILE_MODE
@@ -81,9 +81,15 @@ int fs_dupfd2(int fd1, int fd2)
   /* Get the file structures corresponding to the file descriptors. */
 
   ret = fs_getfilep(fd1, &filep1);
-  if (ret >= 0)
+  if (ret >= 0 && fd1 != fd2)
     {
-      ret = fs_getfilep(fd2, &filep2);
+      /* fd2 may be in a chunk of the file list that is not allocated yet */
+
+      ret = files_extend(nxsched_get_files(), fd2);
+      if (ret >= 0)
+        {
+          ret = fs_getfilep(fd2, &filep2);
+        }
     }
 
   if (ret < 0)
@@ -91,7 +97,7 @@ int fs_dupfd2(int fd1, int fd2)
       return ret;
     }
 
-  DEBUGASSERT(filep1 != NULL && filep2 != NULL);
+  DEBUGASSERT(filep1 != NULL && (filep2 != NULL || fd1 == fd2));
 
   /* Verify that fd1 is a valid, open file descriptor */
 
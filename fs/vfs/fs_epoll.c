@@ -42,25 +42,340 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
+#include <queue.h>
+#include <signal.h>
+#include <assert.h>
 #include <errno.h>
-#include <string.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/signal.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The user events that are passed on to the poll setup of a descriptor.
+ * EPOLLET and EPOLLONESHOT are handled here.
+ */
+
+#define EPOLL_POLLEVENTS (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP)
 
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+struct epoll_head;
+
+/* One registered descriptor.  The poll of the descriptor stays set up
+ * between the calls to epoll_wait().  When the driver or the socket
+ * reports an event, epoll_notify() moves the node to the ready list.
+ */
+
+struct epoll_node
+{
+  dq_entry_t ready;              /* Link in the ready list */
+  dq_entry_t link;               /* Link in the file list or the free list */
+  FAR struct epoll_head *eph;    /* The epoll instance of the node */
+  struct pollfd pfd;             /* The persistent poll of the descriptor */
+  epoll_data_t data;             /* Returned to the user with the events */
+  uint32_t events;               /* The events requested by the user */
+  bool queued;                   /* The node is in the ready list */
+  bool armed;                    /* The poll of the descriptor is set up */
+};
+
 struct epoll_head
 {
-  int size;
-  int occupied;
-  FAR epoll_data_t *data;
-  FAR struct pollfd *poll;
+  dq_entry_t link;               /* Link in the list of epoll instances */
+  int size;                      /* Number of pre-allocated nodes */
+  int occupied;                  /* Number of registered descriptors */
+  sem_t sem;                     /* Posted when a descriptor is notified */
+  sem_t exclsem;                 /* Serializes epoll_ctl() and epoll_wait() */
+  dq_queue_t ready;              /* Nodes with pending events */
+  dq_queue_t files;              /* Nodes of file (non-socket) descriptors */
+  dq_queue_t free;               /* Nodes that are not in use */
+  FAR struct epoll_node *node;   /* The pre-allocated nodes */
 };
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All epoll instances.  epoll_release() visits them when a registered file
+ * or socket is closed.
+ */
+
+static dq_queue_t g_epoll_heads;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_notify
+ *
+ * Description:
+ *   Called by poll_notify() when an event is reported on a registered
+ *   descriptor.  This may run in interrupt context.
+ *
+ ****************************************************************************/
+
+static void epoll_notify(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node *node = container_of(fds, struct epoll_node, pfd);
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!node->queued)
+    {
+      dq_addlast(&node->ready, &node->eph->ready);
+      node->queued = true;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_poll
+ *
+ * Description:
+ *   Set up or tear down the poll of the descriptor of a node.
+ *
+ ****************************************************************************/
+
+static int epoll_poll(FAR struct epoll_node *node, bool setup)
+{
+#ifdef CONFIG_NET
+  if ((node->pfd.events & POLLMASK) == POLLSOCK)
+    {
+      return psock_poll(node->pfd.ptr, &node->pfd, setup);
+    }
+#endif
+
+  return file_poll(node->pfd.ptr, &node->pfd, setup);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Arm the poll of the descriptor of a node.  If the descriptor is
+ *   already ready, the node is added to the ready list at once.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_head *eph,
+                       FAR struct epoll_node *node)
+{
+  int ret;
+
+  node->pfd.events  = (node->pfd.events & POLLMASK) |
+                      (pollevent_t)(node->events & EPOLL_POLLEVENTS) |
+                      POLLERR | POLLHUP;
+  node->pfd.revents = 0;
+  node->pfd.sem     = &eph->sem;
+  node->pfd.priv    = NULL;
+  node->pfd.cb      = epoll_notify;
+
+  ret = epoll_poll(node, true);
+  node->armed = (ret >= 0);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_teardown
+ *
+ * Description:
+ *   Disarm the poll of the descriptor of a node and remove the node from
+ *   the ready list.
+ *
+ ****************************************************************************/
+
+static void epoll_teardown(FAR struct epoll_head *eph,
+                           FAR struct epoll_node *node)
+{
+  irqstate_t flags;
+
+  if (node->armed)
+    {
+      epoll_poll(node, false);
+      node->armed = false;
+    }
+
+  flags = enter_critical_section();
+  if (node->queued)
+    {
+      dq_rem(&node->ready, &eph->ready);
+      node->queued = false;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_remove
+ *
+ * Description:
+ *   Tear down the poll of a node and return the node to the free list.
+ *
+ ****************************************************************************/
+
+static void epoll_remove(FAR struct epoll_head *eph,
+                         FAR struct epoll_node *node)
+{
+  epoll_teardown(eph, node);
+
+  if ((node->pfd.events & POLLMASK) == POLLFILE)
+    {
+      dq_rem(&node->link, &eph->files);
+    }
+
+  node->pfd.fd  = -1;
+  node->pfd.ptr = NULL;
+  dq_addlast(&node->link, &eph->free);
+  eph->occupied--;
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ ****************************************************************************/
+
+static FAR struct epoll_node *epoll_find(FAR struct epoll_head *eph, int fd)
+{
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->node[i].pfd.fd == fd)
+        {
+          return &eph->node[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_collect
+ *
+ * Description:
+ *   Return the events of the nodes in the ready list.  Only the notified
+ *   descriptors are visited, not the whole set.
+ *
+ ****************************************************************************/
+
+static int epoll_collect(FAR struct epoll_head *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node *node;
+  FAR dq_entry_t *entry;
+  dq_queue_t ready;
+  pollevent_t revents;
+  irqstate_t flags;
+  int count = 0;
+
+  /* Drivers that post the semaphore directly instead of calling
+   * poll_notify() only update revents.  Pick up their events here.
+   */
+
+  for (entry = dq_peek(&eph->files); entry != NULL; entry = dq_next(entry))
+    {
+      node = container_of(entry, struct epoll_node, link);
+      if (node->armed && node->pfd.revents != 0)
+        {
+          epoll_notify(&node->pfd);
+        }
+    }
+
+  /* Detach the ready list.  The nodes stay marked as queued until they are
+   * taken from the detached list, so that epoll_notify() does not link a
+   * node into the ready list while it is still in the detached list.
+   */
+
+  flags = enter_critical_section();
+
+  ready = eph->ready;
+  dq_init(&eph->ready);
+
+  leave_critical_section(flags);
+
+  for (; ; )
+    {
+      flags = enter_critical_section();
+      entry = dq_remfirst(&ready);
+      if (entry != NULL)
+        {
+          ((FAR struct epoll_node *)entry)->queued = false;
+        }
+
+      leave_critical_section(flags);
+
+      if (entry == NULL)
+        {
+          break;
+        }
+
+      node = (FAR struct epoll_node *)entry;
+      if (!node->armed)
+        {
+          continue;
+        }
+
+      /* Leave the rest in the ready list for the next call */
+
+      if (count >= maxevents)
+        {
+          epoll_notify(&node->pfd);
+          continue;
+        }
+
+      flags   = enter_critical_section();
+      revents = node->pfd.revents & ~POLLMASK;
+      if ((node->events & EPOLLET) != 0)
+        {
+          node->pfd.revents = 0;
+        }
+
+      leave_critical_section(flags);
+
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[count].data     = node->data;
+      evs[count++].events = revents;
+
+      if ((node->events & EPOLLONESHOT) != 0)
+        {
+          /* Disabled until it is re-armed with EPOLL_CTL_MOD */
+
+          epoll_teardown(eph, node);
+        }
+      else if ((node->events & EPOLLET) == 0)
+        {
+          /* Level-triggered:  Set up the poll again so that the node is
+           * reported again as long as the descriptor stays ready.
+           */
+
+          epoll_teardown(eph, node);
+          epoll_setup(eph, node);
+        }
+    }
+
+  return count;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -78,15 +393,45 @@ struct epoll_head
 
 int epoll_create(int size)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head) +
-                                        sizeof(epoll_data_t) * size +
-                                        sizeof(struct pollfd) * size);
+  FAR struct epoll_head *eph;
+  int i;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  eph = (FAR struct epoll_head *)kmm_zalloc(sizeof(struct epoll_head) +
+                                            sizeof(struct epoll_node) *
+                                            size);
+  if (eph == NULL)
+    {
+      set_errno(ENOMEM);
+      return ERROR;
+    }
 
   eph->size = size;
-  eph->occupied = 0;
-  eph->data = (FAR epoll_data_t *)(eph + 1);
-  eph->poll = (FAR struct pollfd *)(eph->data + size);
+  eph->node = (FAR struct epoll_node *)(eph + 1);
+
+  for (i = 0; i < size; i++)
+    {
+      eph->node[i].eph    = eph;
+      eph->node[i].pfd.fd = -1;
+      dq_addlast(&eph->node[i].link, &eph->free);
+    }
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&eph->sem, 0, 0);
+  nxsem_set_protocol(&eph->sem, SEM_PRIO_NONE);
+  nxsem_init(&eph->exclsem, 0, 1);
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_addlast(&eph->link, &g_epoll_heads);
+  nxsem_post(&g_epoll_sem);
 
   /* REVISIT: This will not work on machines where:
    * sizeof(struct epoll_head *) > sizeof(int)
@@ -138,7 +483,24 @@ void epoll_close(int epfd)
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  int i;
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_rem(&eph->link, &g_epoll_heads);
+  nxsem_post(&g_epoll_sem);
+
+  /* Tear down the polls of all registered descriptors */
 
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->node[i].pfd.fd >= 0)
+        {
+          epoll_teardown(eph, &eph->node[i]);
+        }
+    }
+
+  nxsem_destroy(&eph->sem);
+  nxsem_destroy(&eph->exclsem);
   kmm_free(eph);
 }
 
@@ -160,6 +522,22 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  FAR struct epoll_node *node;
+  FAR dq_entry_t *entry;
+  int ret;
+
+  if (fd < 0)
+    {
+      return -EBADF;
+    }
+
+  ret = nxsem_wait_uninterruptible(&eph->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  node = epoll_find(eph, fd);
 
   switch (op)
     {
@@ -167,57 +545,105 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
         finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
               epfd, eph->occupied, fd, ev->events);
 
-        eph->data[eph->occupied]        = ev->data;
-        eph->poll[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->poll[eph->occupied++].fd   = fd;
-        return 0;
+        if (node != NULL)
+          {
+            ret = -EEXIST;
+            break;
+          }
+
+        entry = dq_remfirst(&eph->free);
+        if (entry == NULL)
+          {
+            ret = -ENOMEM;
+            break;
+          }
+
+        node = container_of(entry, struct epoll_node, link);
+
+        /* Find the file or the socket of the descriptor.  It is polled
+         * directly from now on.
+         */
+
+        if (fd >= CONFIG_NFILE_DESCRIPTORS)
+          {
+#ifdef CONFIG_NET
+            node->pfd.ptr    = sockfd_socket(fd);
+            node->pfd.events = POLLSOCK;
+            ret              = node->pfd.ptr != NULL ? OK : -EBADF;
+#else
+            ret              = -EBADF;
+#endif
+          }
+        else
+          {
+            FAR struct file *filep = NULL;
+
+            ret = fs_getfilep(fd, &filep);
+            node->pfd.ptr    = filep;
+            node->pfd.events = POLLFILE;
+          }
+
+        if (ret >= 0)
+          {
+            node->data   = ev->data;
+            node->events = ev->events;
+            node->pfd.fd = fd;
+
+            ret = epoll_setup(eph, node);
+          }
+
+        if (ret < 0)
+          {
+            node->pfd.fd = -1;
+            dq_addlast(&node->link, &eph->free);
+            break;
+          }
+
+        if ((node->pfd.events & POLLMASK) == POLLFILE)
+          {
+            dq_addlast(&node->link, &eph->files);
+          }
+
+        eph->occupied++;
+        break;
 
       case EPOLL_CTL_DEL:
-        {
-          int i;
+        if (node == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->poll[i].fd == fd)
-                {
-                  if (i != eph->occupied - 1)
-                    {
-                      memmove(&eph->data[i], &eph->data[i + 1],
-                              sizeof(epoll_data_t) * (eph->occupied - i));
-                      memmove(&eph->poll[i], &eph->poll[i + 1],
-                              sizeof(struct pollfd) * (eph->occupied - i));
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
-
-          return -ENOENT;
-        }
+        epoll_remove(eph, node);
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
+              epfd, eph->occupied, fd, ev->events);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+        if (node == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->poll[i].fd == fd)
-                {
-                  eph->data[i]        = ev->data;
-                  eph->poll[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
-            }
+        /* This also re-arms a node that was disabled by EPOLLONESHOT */
 
-          return -ENOENT;
-        }
+        epoll_teardown(eph, node);
+
+        node->data   = ev->data;
+        node->events = ev->events;
+
+        ret = epoll_setup(eph, node);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
     }
 
-  return -EINVAL;
+  nxsem_post(&eph->exclsem);
+  return ret;
 }
 
 /****************************************************************************
@@ -232,61 +658,104 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  sigset_t oldmask;
+  clock_t start;
+  clock_t ticks = 0;
+  int ret;
+
+  /* epoll_pwait() is a cancellation point */
 
-  if (timeout < 0)
+  enter_cancellation_point();
+
+  if (evs == NULL || maxevents <= 0)
     {
-      rc = ppoll(eph->poll, eph->occupied, NULL, sigmask);
+      leave_cancellation_point();
+      set_errno(EINVAL);
+      return ERROR;
     }
-  else
-    {
-      struct timespec timeout_ts;
 
-      timeout_ts.tv_sec  = timeout / 1000;
-      timeout_ts.tv_nsec = timeout % 1000 * 1000;
+  if (timeout > 0)
+    {
+      /* Round timeout up to next full tick, as poll() does */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+              MSEC_PER_TICK;
+#endif
+    }
 
-      rc = ppoll(eph->poll, eph->occupied, &timeout_ts, sigmask);
+  if (sigmask != NULL)
+    {
+      nxsig_procmask(SIG_SETMASK, sigmask, &oldmask);
     }
 
-  if (rc <= 0)
+  start = clock_systime_ticks();
+
+  for (; ; )
     {
-      if (rc < 0)
+      ret = nxsem_wait(&eph->exclsem);
+      if (ret < 0)
         {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+          break;
+        }
+
+      /* Consume the notifications of the events that are collected now */
 
-          for (i = 0; i < eph->occupied; i++)
+      while (nxsem_trywait(&eph->sem) >= 0);
+
+      ret = epoll_collect(eph, evs, maxevents);
+      nxsem_post(&eph->exclsem);
+
+      if (ret > 0 || timeout == 0)
+        {
+          break;
+        }
+
+      /* Nothing is ready.  Wait for the next notification, for a signal
+       * or for the timeout to elapse.
+       */
+
+      if (timeout < 0)
+        {
+          ret = nxsem_wait(&eph->sem);
+        }
+      else
+        {
+          ret = nxsem_tickwait(&eph->sem, start, ticks);
+        }
+
+      if (ret < 0)
+        {
+          if (ret == -ETIMEDOUT)
             {
-              ferr("  %02d: fd=%d\n", i, eph->poll[i].fd);
+              /* Return zero (OK) in the event of a timeout */
+
+              ret = OK;
             }
-        }
 
-      return rc;
+          break;
+        }
     }
 
-  /* Iterate over non NULL event fds */
-
-  if (rc > maxevents)
+  if (sigmask != NULL)
     {
-      rc = maxevents;
+      nxsig_procmask(SIG_SETMASK, &oldmask, NULL);
     }
 
-  for (i = 0, counter = 0; i < rc && counter < eph->occupied; counter++)
+  leave_cancellation_point();
+
+  if (ret < 0)
     {
-      if (eph->poll[counter].revents != 0)
-        {
-          evs[i].data     = eph->data[counter];
-          evs[i++].events = eph->poll[counter].revents;
-          if (eph->poll[counter].events & EPOLLONESHOT)
-            {
-              eph->poll[counter].events = 0; /* Disable oneshot internally */
-            }
-        }
+      set_errno(-ret);
+      return ERROR;
     }
 
-  return i;
+  return ret;
 }
 
 /****************************************************************************
@@ -305,3 +774,55 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs,
 {
   return epoll_pwait(epfd, evs, maxevents, timeout, NULL);
 }
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Drop the registrations of a file or a socket that is being closed from
+ *   all epoll instances, as Linux does when the last reference to a file
+ *   goes away.  This is called before the close method of the driver or
+ *   the socket, while the poll can still be torn down.
+ *
+ * Input Parameters:
+ *   ptr - The file or the socket structure that is being closed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR void *ptr)
+{
+  FAR struct epoll_head *eph;
+  FAR dq_entry_t *entry;
+  int i;
+
+  /* Nothing to do when no epoll instance exists */
+
+  if (dq_empty(&g_epoll_heads))
+    {
+      return;
+    }
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+
+  for (entry = dq_peek(&g_epoll_heads); entry != NULL;
+       entry = dq_next(entry))
+    {
+      eph = container_of(entry, struct epoll_head, link);
+
+      nxsem_wait_uninterruptible(&eph->exclsem);
+      for (i = 0; i < eph->size; i++)
+        {
+          if (eph->node[i].pfd.fd >= 0 && eph->node[i].pfd.ptr == ptr)
+            {
+              epoll_remove(eph, &eph->node[i]);
+            }
+        }
+
+      nxsem_post(&eph->exclsem);
+    }
+
+  nxsem_post(&g_epoll_sem);
+}
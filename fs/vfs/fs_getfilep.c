@@ -73,6 +73,7 @@
 int fs_getfilep(int fd, FAR struct file **filep)
 {
   FAR struct filelist *list;
+  FAR struct file *file;
 
   DEBUGASSERT(filep != NULL);
   *filep = (FAR struct file *)NULL;
@@ -100,8 +101,17 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  /* And return the file pointer from the list */
+  /* And return the file pointer from the list.  This does not need the list
+   * semaphore.  If the chunk of the descriptor has not been allocated, then
+   * the descriptor has never been opened.
+   */
+
+  file = files_fget(list, fd);
+  if (file == NULL)
+    {
+      return -EBADF;
+    }
 
-  *filep = &list->fl_files[fd];
+  *filep = file;
   return OK;
 }
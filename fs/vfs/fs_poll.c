@@ -138,6 +138,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
        * events shall be ignored, and revents shall be set to 0 in that entry
@@ -347,7 +348,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
 
@@ -397,6 +398,33 @@ int fs_poll(int fd, FAR struct pollfd *fds, bool setup)
   return file_poll(filep, fds, setup);
 }
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Notify the waiter of a poll event.  Drivers call this after updating
+ *   fds->revents, instead of posting fds->sem directly.  If the waiter
+ *   installed a callback in fds->cb, that callback is called before
+ *   fds->sem is posted.
+ *
+ * Input Parameters:
+ *   fds - The poll structure whose revents have been updated
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds)
+{
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+
+  poll_semgive(fds->sem);
+}
+
 /****************************************************************************
  * Name: nx_poll
  *
@@ -41,6 +41,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -69,5 +70,33 @@
 #define TCP_KEEPCNT   (__SO_PROTOCOL + 3) /* Number of keepalives before death
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
+#define TCP_INFO      (__SO_PROTOCOL + 5) /* Connection information
+                                           * Argument: struct tcp_info */
+#define TCP_CONGESTION (__SO_PROTOCOL + 6) /* Congestion control algorithm
+                                            * Argument: name string */
+
+/* The maximum length of the name of a congestion control algorithm */
+
+#define TCP_CA_NAME_MAX 16
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* The argument of the TCP_INFO socket option.  This is a subset of the
+ * Linux structure.
+ */
+
+struct tcp_info
+{
+  uint8_t  tcpi_state;        /* TCP state */
+  uint8_t  tcpi_retransmits;  /* Retransmissions of the current segment */
+  uint32_t tcpi_rto;          /* Retransmission time-out (usec) */
+  uint32_t tcpi_snd_mss;      /* Maximum segment size */
+  uint32_t tcpi_rtt;          /* Smoothed round-trip time (usec) */
+  uint32_t tcpi_rttvar;       /* Round-trip time variation (usec) */
+  uint32_t tcpi_snd_ssthresh; /* Slow start threshold (segments) */
+  uint32_t tcpi_snd_cwnd;     /* Congestion window (segments) */
+};
 
 #endif /* __INCLUDE_NETINET_TCP_H */
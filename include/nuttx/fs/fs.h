@@ -412,12 +412,31 @@ struct file
   void             *f_priv;     /* Per file driver private data */
 };
 
-/* This defines a list of files indexed by the file descriptor */
+/* This defines a list of files indexed by the file descriptor.
+ *
+ * The files are allocated in chunks of FILELIST_CHUNK as the descriptors
+ * are used, so CONFIG_NFILE_DESCRIPTORS may be large without allocating
+ * that many files for each task.  A chunk is never moved or freed before
+ * the list is released.  So files_fget() does not need the list semaphore.
+ * fl_used has one bit for each descriptor that is in use.  A chunk is no
+ * larger than the whole list, so a small list uses no more memory than a
+ * fixed array.
+ */
+
+#if CONFIG_NFILE_DESCRIPTORS < 32
+#  define FILELIST_CHUNK CONFIG_NFILE_DESCRIPTORS
+#else
+#  define FILELIST_CHUNK 32
+#endif
+
+#define FILELIST_NCHUNKS \
+  ((CONFIG_NFILE_DESCRIPTORS + FILELIST_CHUNK - 1) / FILELIST_CHUNK)
 
 struct filelist
 {
   sem_t   fl_sem;               /* Manage access to the file list */
-  struct file fl_files[CONFIG_NFILE_DESCRIPTORS];
+  uint32_t fl_used[FILELIST_NCHUNKS];
+  FAR struct file *volatile fl_files[FILELIST_NCHUNKS];
 };
 
 /* The following structure defines the list of files used for standard C I/O.
@@ -742,6 +761,38 @@ void files_initlist(FAR struct filelist *list);
 
 void files_releaselist(FAR struct filelist *list);
 
+/****************************************************************************
+ * Name: files_fget
+ *
+ * Description:
+ *   Return the file structure of a file descriptor in the list.  The file
+ *   may or may not be open.  The list semaphore is not needed.
+ *
+ * Returned Value:
+ *   The file structure or NULL if the descriptor is out of range or if its
+ *   chunk of the list has not been allocated.  The descriptor cannot be
+ *   open in that case.
+ *
+ ****************************************************************************/
+
+FAR struct file *files_fget(FAR struct filelist *list, int fd);
+
+/****************************************************************************
+ * Name: files_extend
+ *
+ * Description:
+ *   Make sure that the chunk of the list that holds the file descriptor
+ *   'fd' is allocated.  This is needed before a file is assigned to a
+ *   specific descriptor, as dup2() does.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int files_extend(FAR struct filelist *list, int fd);
+
 /****************************************************************************
  * Name: file_dup
  *
@@ -1393,6 +1444,46 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
 int fs_poll(int fd, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Notify the waiter of a poll event.  Drivers call this after updating
+ *   fds->revents, instead of posting fds->sem directly.  If the waiter
+ *   installed a callback in fds->cb, that callback is called before
+ *   fds->sem is posted.  epoll() uses this to maintain a list of the ready
+ *   descriptors.
+ *
+ *   This may be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   fds - The poll structure whose revents have been updated
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds);
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Drop the registrations of a file or a socket that is being closed from
+ *   all epoll instances.  This is called before the close method of the
+ *   driver or the socket.
+ *
+ * Input Parameters:
+ *   ptr - The file or the socket structure that is being closed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR void *ptr);
+
 /****************************************************************************
  * Name: nx_poll
  *
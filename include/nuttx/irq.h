@@ -44,6 +44,7 @@
 #include <nuttx/config.h>
 
 #ifndef __ASSEMBLY__
+# include <stdbool.h>
 # include <stdint.h>
 # include <assert.h>
 #endif
@@ -120,6 +121,32 @@ typedef uint32_t irq_mapped_t;
 /* This struct defines the form of an interrupt service routine */
 
 typedef CODE int (*xcpt_t)(int irq, FAR void *context, FAR void *arg);
+
+/* Lock classes used with spin_lock_irqsave_class().  Each class names a
+ * subsystem that protects its private data with its own critical section.
+ * IRQLOCK_GLOBAL is the global IRQ lock taken by enter_critical_section().
+ */
+
+enum irqlock_class_e
+{
+  IRQLOCK_GLOBAL = 0,           /* enter_critical_section() */
+  IRQLOCK_WDOG,                 /* Watchdog timer lists */
+  IRQLOCK_SEMAPHORE,            /* Semaphore counts and wait lists */
+  IRQLOCK_MQUEUE,               /* Message queue free message lists */
+  IRQLOCK_WQUEUE,               /* Work queue lists */
+  IRQLOCK_NCLASSES              /* Number of lock classes */
+};
+
+#ifdef CONFIG_SPINLOCK_STATS
+/* Lock statistics for one lock class on one CPU */
+
+struct irqlock_stat_s
+{
+  uint32_t acquired;            /* Number of times the lock was taken */
+  uint32_t contended;           /* Number of times the lock was busy */
+  uint32_t spins;               /* Number of failed attempts while busy */
+};
+#endif
 #endif /* __ASSEMBLY__ */
 
 /****************************************************************************
@@ -149,6 +176,23 @@ extern "C"
 /* EXTERN const irq_mapped_t g_irqmap[NR_IRQS]; */
 #endif
 
+#ifdef CONFIG_SPINLOCK_STATS
+/* Per-CPU lock statistics for each lock class.  These are exported via
+ * /proc/lockstat.
+ */
+
+EXTERN struct irqlock_stat_s
+  g_irqlock_stat[CONFIG_SMP_NCPUS][IRQLOCK_NCLASSES];
+#endif
+
+#ifdef CONFIG_SMP_SCOPEDLOCKS
+/* True for each lock class that uses its own spinlock rather than the
+ * global IRQ lock.
+ */
+
+EXTERN const bool g_irqlock_scoped[IRQLOCK_NCLASSES];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -294,6 +338,62 @@ void spin_unlock_irqrestore(irqstate_t flags);
 #  define spin_unlock_irqrestore(f) leave_critical_section(f)
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_irqsave_class
+ *
+ * Description:
+ *   If SMP and SMP_SCOPEDLOCKS are enabled and the lock class has been
+ *   converted to a scoped lock:
+ *     Disable local interrupts and take the spinlock of the lock class.
+ *     The scoped lock is not re-entrant and must not be held while calling
+ *     enter_critical_section() or any function that may suspend the
+ *     caller.
+ *
+ *   Otherwise:
+ *     This function is equivalent to enter_critical_section().
+ *
+ *   If SPINLOCK_STATS is enabled, the use of the lock is accounted to the
+ *   lock class in either case.
+ *
+ * Input Parameters:
+ *   lockclass - One of enum irqlock_class_e
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_class();
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_irqsave_class(int lockclass);
+#else
+#  define spin_lock_irqsave_class(c) enter_critical_section()
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore_class
+ *
+ * Description:
+ *   Release the lock taken by spin_lock_irqsave_class() and restore the
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   lockclass - The lock class passed to spin_lock_irqsave_class()
+ *   flags     - The architecture-specific value that represents the state
+ *               of the interrupts prior to the call to
+ *               spin_lock_irqsave_class();
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_irqrestore_class(int lockclass, irqstate_t flags);
+#else
+#  define spin_unlock_irqrestore_class(c,f) leave_critical_section(f)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
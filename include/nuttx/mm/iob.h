@@ -85,10 +85,34 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* Large I/O buffers are optional.  They are used when the length of the
+ * data is known to be more than CONFIG_IOB_BUFSIZE so that large packets
+ * do not need long chains of small buffers.
+ */
+
+#if !defined(CONFIG_IOB_LARGE_NBUFFERS)
+#  define CONFIG_IOB_LARGE_NBUFFERS 0
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+#  if CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#    error CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  endif
+#  define IOB_MAXBUFSIZE CONFIG_IOB_LARGE_BUFSIZE
+#else
+#  define IOB_MAXBUFSIZE CONFIG_IOB_BUFSIZE
+#endif
+
 /* IOB helpers */
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -104,6 +128,10 @@
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
+ *
+ * If large I/O buffers are enabled, a chain may hold buffers of both sizes
+ * and the payload is referenced by a pointer.  Use IOB_BUFSIZE() to get the
+ * size of the payload of one buffer.
  */
 
 struct iob_s
@@ -114,7 +142,7 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#if IOB_MAXBUFSIZE < 256
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
@@ -123,7 +151,12 @@ struct iob_s
 #endif
   uint16_t io_pktlen;   /* Total length of the packet */
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  uint16_t io_bufsize;  /* Size of the payload buffer */
+  FAR uint8_t *io_data; /* The payload buffer */
+#else
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
+#endif
 };
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -203,6 +236,9 @@ enum iob_user_e
 #ifdef CONFIG_NET_IPFORWARD
   IOBUSER_NET_IPFORWARD,
 #endif
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  IOBUSER_NET_NETDEV,
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   IOBUSER_WIRELESS_RAD802154,
 #endif
@@ -234,6 +270,18 @@ struct iob_userstats_s
   int totalproduced;
 };
 
+/* IOB usage statistics of one CPU */
+
+struct iob_cpustats_s
+{
+  int totalconsumed;    /* IOBs allocated on this CPU */
+  int totalproduced;    /* IOBs freed on this CPU */
+  int cached;           /* IOBs held in the cache of this CPU */
+  int hits;             /* IOBs allocated from the cache */
+  int refills;          /* Batches taken from the global free list */
+  int drains;           /* Batches returned to the global free list */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -270,6 +318,55 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid);
 
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
+/****************************************************************************
+ * Name: iob_alloc_len
+ *
+ * Description:
+ *   Allocate an I/O buffer for 'len' bytes of data.  A large I/O buffer is
+ *   taken if 'len' does not fit in a standard buffer and a large buffer is
+ *   free.  Otherwise, this is the same as iob_alloc().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_len(unsigned int len, bool throttled,
+                                enum iob_user_e consumerid);
+
+/****************************************************************************
+ * Name: iob_tryalloc_len
+ *
+ * Description:
+ *   Allocate an I/O buffer for 'len' bytes of data, like iob_alloc_len(),
+ *   but without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_len(unsigned int len, bool throttled,
+                                   enum iob_user_e consumerid);
+
+/****************************************************************************
+ * Name: iob_alloc_batch
+ *
+ * Description:
+ *   Allocate 'count' I/O buffers linked into one chain.  As many buffers as
+ *   possible are taken at once from the per-CPU cache and the free list.
+ *   If called from a thread, this waits for the remaining buffers like
+ *   iob_alloc().  Otherwise, the allocation fails if not enough buffers
+ *   are free.
+ *
+ * Input Parameters:
+ *   count      - The number of I/O buffers to allocate
+ *   throttled  - An indication of the IOB allocation is "throttled"
+ *   consumerid - id representing who is consuming the IOBs
+ *
+ * Returned Value:
+ *   The head of the I/O buffer chain or NULL if the buffers could not be
+ *   allocated.  No buffer is allocated in that case.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_batch(int count, bool throttled,
+                                  enum iob_user_e consumerid);
+
 /****************************************************************************
  * Name: iob_navail
  *
@@ -587,15 +684,41 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
 #  define iob_dump(wrb)
 #endif
 
+/****************************************************************************
+ * Name: iob_stats_handover
+ *
+ * Description:
+ *   An IOB is handed over from one user to another without being freed and
+ *   allocated again.  It is accounted as freed by the producer and as
+ *   allocated by the consumer.
+ *
+ * Input Parameters:
+ *   producerid - id representing the user that gives up the IOB
+ *   consumerid - id representing the user that takes the IOB
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_stats_handover(enum iob_user_e producerid,
+                        enum iob_user_e consumerid);
+#else
+#  define iob_stats_handover(p,c)
+#endif
+
 /****************************************************************************
  * Name: iob_getuserstats
  *
  * Description:
- *   Return a reference to the IOB usage statistics for the IOB
- *   consumer/producer
+ *   Return the IOB usage statistics for the IOB consumer/producer, summed
+ *   over all CPUs.
  *
  * Input Parameters:
  *   userid - id representing the IOB producer/consumer
+ *   stats  - Location to return the statistics
  *
  * Returned Value:
  *   None.
@@ -604,7 +727,29 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
-FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid);
+void iob_getuserstats(enum iob_user_e userid,
+                      FAR struct iob_userstats_s *stats);
+#endif
+
+/****************************************************************************
+ * Name: iob_getcpustats
+ *
+ * Description:
+ *   Return the IOB usage statistics of one CPU.
+ *
+ * Input Parameters:
+ *   cpu   - The CPU index
+ *   stats - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if 'cpu' is not
+ *   a valid CPU index.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+int iob_getcpustats(int cpu, FAR struct iob_cpustats_s *stats);
 #endif
 
 #endif /* CONFIG_MM_IOB */
@@ -32,6 +32,11 @@
 #include <string.h>
 #include <semaphore.h>
 
+#ifdef CONFIG_MM_SIZECLASS
+#  include <nuttx/irq.h>
+#  include <nuttx/spinlock.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -147,6 +152,20 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* TLSF free list definitions.  Free chunks are kept in a two-level array
+ * of free lists.  The first level index is the position of the most
+ * significant bit of the chunk size; the second level divides each power
+ * of two range linearly into MM_TLSF_SLCOUNT lists.  All chunks smaller
+ * than (1 << MM_TLSF_FLSHIFT) share first level index zero.
+ */
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+#  define MM_TLSF_SLBITS   CONFIG_MM_TLSF_SLBITS
+#  define MM_TLSF_SLCOUNT  (1 << MM_TLSF_SLBITS)
+#  define MM_TLSF_FLSHIFT  (MM_MIN_SHIFT + MM_TLSF_SLBITS)
+#  define MM_TLSF_FLCOUNT  (8 * sizeof(mmsize_t) - MM_TLSF_FLSHIFT)
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -163,6 +182,42 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0)
 
+/* Heap profiling.  Each allocated chunk is tagged with the PID of the
+ * task that allocated it and the running totals of that task are updated.
+ * Only heaps that can reach the TCBs, i.e., not the user heap of a
+ * protected or kernel build, can be profiled.
+ */
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_PROFILE 1
+#  endif
+
+#  define MM_PID_NONE ((mmsize_t)-1)
+#endif
+
+/* Size class caches.  Small chunks are released into a per-CPU cache of
+ * their size class and are reused from there without taking the heap
+ * semaphore.  The caches can only be used where interrupts can be
+ * disabled, i.e., not for the user heap of a protected or kernel build.
+ */
+
+#ifdef CONFIG_MM_SIZECLASS
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_SIZECLASS 1
+#  endif
+
+#  define MM_SIZECLASS_MAXCHUNK \
+     MM_ALIGN_UP(CONFIG_MM_SIZECLASS_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#  define MM_SIZECLASS_NCLASSES (MM_SIZECLASS_MAXCHUNK >> MM_MIN_SHIFT)
+
+#  ifdef CONFIG_SMP
+#    define MM_SIZECLASS_NCPUS  CONFIG_SMP_NCPUS
+#  else
+#    define MM_SIZECLASS_NCPUS  1
+#  endif
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -186,14 +241,26 @@ struct mm_allocnode_s
 {
   mmsize_t size;           /* Size of this chunk */
   mmsize_t preceding;      /* Size of the preceding chunk */
+#ifdef CONFIG_MM_HEAP_PROFILE
+  mmsize_t pid;            /* PID of the owner or MM_PID_NONE */
+  mmsize_t seqno;          /* Sequence number of the allocation */
+#endif
 };
 
 /* What is the size of the allocnode? */
 
-#ifdef CONFIG_MM_SMALL
-# define SIZEOF_MM_ALLOCNODE   B2C(4)
+#ifdef CONFIG_MM_HEAP_PROFILE
+#  ifdef CONFIG_MM_SMALL
+#    define SIZEOF_MM_ALLOCNODE B2C(8)
+#  else
+#    define SIZEOF_MM_ALLOCNODE B2C(16)
+#  endif
 #else
-# define SIZEOF_MM_ALLOCNODE   B2C(8)
+#  ifdef CONFIG_MM_SMALL
+#    define SIZEOF_MM_ALLOCNODE B2C(4)
+#  else
+#    define SIZEOF_MM_ALLOCNODE B2C(8)
+#  endif
 #endif
 
 #define CHECK_ALLOCNODE_SIZE \
@@ -214,10 +281,32 @@ struct mm_delaynode_s
   struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_SIZECLASS
+/* The size class caches of one CPU.  Each cache is a singly linked list of
+ * allocated chunks of exactly the same size, linked through the flink
+ * field of struct mm_freenode_s.
+ */
+
+struct mm_sizeclass_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t sc_lock;              /* Taken when another CPU flushes */
+#endif
+  FAR struct mm_freenode_s *sc_head[MM_SIZECLASS_NCLASSES];
+  uint8_t sc_count[MM_SIZECLASS_NCLASSES];
+};
+#endif
+
 /* What is the size of the freenode? */
 
 #define MM_PTR_SIZE sizeof(FAR struct mm_freenode_s *)
-#define SIZEOF_MM_FREENODE (SIZEOF_MM_ALLOCNODE + 2*MM_PTR_SIZE)
+#ifdef CONFIG_MM_HEAP_PROFILE
+/* The free list links overlay the owner fields of struct mm_allocnode_s */
+
+#  define SIZEOF_MM_FREENODE (SIZEOF_MM_ALLOCNODE / 2 + 2*MM_PTR_SIZE)
+#else
+#  define SIZEOF_MM_FREENODE (SIZEOF_MM_ALLOCNODE + 2*MM_PTR_SIZE)
+#endif
 
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
@@ -247,16 +336,39 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF_MANAGER
+  /* All free nodes are maintained in TLSF free lists.  mm_flmap has one
+   * bit set for each first level index with a non-empty list;
+   * mm_slmap[fl] has one bit set for each non-empty second level list.
+   */
+
+  uint32_t mm_flmap;
+  uint32_t mm_slmap[MM_TLSF_FLCOUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_TLSF_FLCOUNT][MM_TLSF_SLCOUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
 
   /* Free delay list, for some situation can't do free immdiately */
 
   struct mm_delaynode_s *mm_delaylist;
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+  /* Sequence number of the last allocation */
+
+  mmsize_t mm_seqno;
+#endif
+
+#ifdef CONFIG_MM_SIZECLASS
+  /* Per-CPU caches of small chunks */
+
+  struct mm_sizeclass_s mm_sizeclass[MM_SIZECLASS_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -370,6 +482,7 @@ FAR void *kmm_malloc(size_t size);
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
 
 /* Functions contained in kmm_free.c ****************************************/
 
@@ -492,14 +605,44 @@ struct mallinfo kmm_mallinfo(void);
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c ********************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c or mm_tlsf.c ********************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c or mm_tlsf.c *******************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
+#ifndef CONFIG_MM_TLSF_MANAGER
 int mm_size2ndx(size_t size);
+#endif
+
+/* Functions contained in mm_profile.c **************************************/
+
+#ifdef MM_HAVE_PROFILE
+void mm_profile_alloc(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_profile_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_profile_move(FAR struct mm_heap_s *heap, FAR void *mem,
+                     FAR const struct mm_allocnode_s *old);
+#endif
+
+/* Functions contained in mm_sizeclass.c ************************************/
+
+#ifdef MM_HAVE_SIZECLASS
+FAR void *mm_sizeclass_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_sizeclass_free(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_sizeclass_flush(FAR struct mm_heap_s *heap);
+int  mm_sizeclass_info(FAR struct mm_heap_s *heap, FAR size_t *cached);
+#endif
 
 #undef EXTERN
 #ifdef __cplusplus
@@ -1082,6 +1082,82 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_recvmsg and psock_sendmsg
+ *
+ * Description:
+ *   Internal OS interfaces that are functionally equivalent to recvmsg()
+ *   and sendmsg() except that they are not cancellation points, they do
+ *   not modify the errno variable and they accept the internal socket
+ *   structure as an input rather than a task-specific socket descriptor.
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket with a
+ *   single acquisition of the network lock.  This is an internal OS
+ *   interface.  It is functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of messages to receive
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags
+ *   timeout - Time limit on the whole operation (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  The msg_len
+ *   field of each message holds the number of bytes received.  If no
+ *   message could be received, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' messages on a socket with a single
+ *   acquisition of the network lock.  This is an internal OS interface.  It
+ *   is functionally equivalent to sendmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of messages to send
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  The msg_len field of
+ *   each message holds the number of bytes sent.  If no message could be
+ *   sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
@@ -411,6 +411,18 @@
 #  define TCP_RTO 3
 #endif
 
+/* The bounds of the retransmission timeout when it is calculated from the
+ * measured round-trip time (units: milliseconds).
+ */
+
+#ifdef CONFIG_NET_TCP_RTO_MIN
+#  define TCP_RTO_MIN CONFIG_NET_TCP_RTO_MIN
+#else
+#  define TCP_RTO_MIN 1000
+#endif
+
+#define TCP_RTO_MAX 60000
+
 /* The maximum number of times a segment should be retransmitted
  * before the connection should be aborted.
  *
@@ -220,6 +220,7 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference */
 
 struct net_driver_s
 {
@@ -301,6 +302,18 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  /* If not NULL, d_buf lies in the payload of this I/O buffer.  The I/O
+   * buffer always belongs to the driver, but the network may exchange it
+   * for another one while an incoming packet is processed.  In that case,
+   * the original I/O buffer is kept in a read-ahead queue and d_buf, d_iob
+   * and d_appdata refer to the new I/O buffer when the input function
+   * returns.
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -507,6 +520,12 @@ int sixlowpan_input(FAR struct radio_driver_s *ieee,
  * is set to a value larger than zero. The device driver should then send
  * out the packet.
  *
+ * A driver with several TX buffers may point d_buf to the next free buffer
+ * and return zero to receive several packets in one poll.  A TCP connection
+ * is then polled again after each segment that it sends, up to
+ * CONFIG_NET_TCP_TXBATCH segments, so that bulk data fills the TX buffers
+ * without a round trip through the driver for each segment.
+ *
  * Example:
  *   int driver_callback(FAR struct net_driver_s *dev)
  *   {
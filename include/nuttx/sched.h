@@ -739,6 +739,15 @@ struct tcb_s
   uint32_t crit_max;                     /* Max time in critical section        */
 #endif
 
+  /* Heap profiling support *****************************************************/
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+  size_t   heap_bytes;                   /* Heap bytes currently allocated      */
+  size_t   heap_peak;                    /* Max heap bytes allocated            */
+  uint32_t heap_allocs;                  /* Number of heap allocations          */
+  uint32_t heap_frees;                   /* Number of heap chunks freed         */
+#endif
+
   /* State save areas ***********************************************************/
 
   /* The form and content of these fields are platform-specific.                */
@@ -110,6 +110,11 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* The type of the function that is called by poll_notify() */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the Nuttx variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -132,6 +137,7 @@ struct pollfd
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
   FAR void    *priv;    /* For use by drivers */
+  pollcb_t     cb;      /* Called by poll_notify() before sem is posted */
 };
 
 /****************************************************************************
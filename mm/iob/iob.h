@@ -46,6 +46,7 @@
 
 #include <nuttx/mm/iob.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_MM_IOB
 
@@ -63,6 +64,20 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* Number of sets of per-CPU data */
+
+#ifdef CONFIG_SMP
+#  define IOB_NCPUS              CONFIG_SMP_NCPUS
+#else
+#  define IOB_NCPUS              1
+#endif
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+#  if CONFIG_IOB_PERCPU_BATCH >= CONFIG_IOB_PERCPU_DEPTH
+#    error CONFIG_IOB_PERCPU_BATCH must be less than CONFIG_IOB_PERCPU_DEPTH
+#  endif
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -75,6 +90,12 @@ extern FAR struct iob_s *g_iob_freelist;
 
 extern FAR struct iob_s *g_iob_committed;
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* A list of all free, unallocated large I/O buffers */
+
+extern FAR struct iob_s *g_iob_largelist;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -95,10 +116,165 @@ extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
 extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
 #endif
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+/* The number of threads that may be waiting for a free IOB.  Freed IOBs
+ * are not cached while this is non-zero.  Modified only within a critical
+ * section.
+ */
+
+extern volatile int g_iob_waiters;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_pool_alloc
+ *
+ * Description:
+ *   Take up to 'count' I/O buffers from the global free list in one
+ *   critical section and add them to the head of 'list'.  The IOB
+ *   semaphore counts are decremented for each buffer.  The buffers are not
+ *   initialized.
+ *
+ * Input Parameters:
+ *   list      - The list that receives the I/O buffers
+ *   count     - The maximum number of I/O buffers to take
+ *   throttled - An indication of the IOB allocation is "throttled"
+ *
+ * Returned Value:
+ *   The number of I/O buffers that were added to the list.
+ *
+ ****************************************************************************/
+
+int iob_pool_alloc(FAR struct iob_s **list, int count, bool throttled);
+
+/****************************************************************************
+ * Name: iob_pool_free
+ *
+ * Description:
+ *   Return a NULL terminated list of I/O buffers to the global free list,
+ *   or to the committed list if there are waiters, in one critical section.
+ *   The IOB semaphores are posted for each buffer.
+ *
+ * Input Parameters:
+ *   list - The list of I/O buffers linked by io_flink
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_pool_free(FAR struct iob_s *list);
+
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Free a NULL terminated list of I/O buffers, through the per-CPU cache
+ *   if it is enabled.  This is common logic for iob_free() and
+ *   iob_free_chain().
+ *
+ * Input Parameters:
+ *   list       - The list of I/O buffers linked by io_flink
+ *   producerid - id representing who is producing the IOBs
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_free_list(FAR struct iob_s *list, enum iob_user_e producerid);
+
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Take up to 'count' I/O buffers from the cache of this CPU and add them
+ *   to the head of 'list'.  An empty cache is refilled from the global free
+ *   list in one batch.  The cached buffers are above the throttle limit
+ *   and may be used for any allocation.  The buffers are not initialized.
+ *
+ * Input Parameters:
+ *   list  - The list that receives the I/O buffers
+ *   count - The maximum number of I/O buffers to take
+ *
+ * Returned Value:
+ *   The number of I/O buffers that were added to the list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+int iob_cache_alloc(FAR struct iob_s **list, int count);
+#endif
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Add a NULL terminated list of I/O buffers to the cache of this CPU.  If
+ *   the cache overflows, the oldest buffers are drained in one batch.
+ *
+ * Input Parameters:
+ *   list - The list of I/O buffers linked by io_flink
+ *
+ * Returned Value:
+ *   The list of I/O buffers that were not cached.  The caller must return
+ *   them to the global free list with iob_pool_free().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+FAR struct iob_s *iob_cache_free(FAR struct iob_s *list);
+#endif
+
+/****************************************************************************
+ * Name: iob_cache_flush
+ *
+ * Description:
+ *   Return the I/O buffers in the caches of all CPUs to the global free
+ *   list.  This is done when an allocation cannot otherwise be satisfied.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   true if any I/O buffer was returned to the global free list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+bool iob_cache_flush(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_cache_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers held in the caches of all CPUs.  The
+ *   value is not locked and may be stale.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+int iob_cache_navail(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_cache_stats
+ *
+ * Description:
+ *   Add the cache statistics of one CPU to 'stats'.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_IOB_PERCPU_CACHE) && \
+    !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_cache_stats(int cpu, FAR struct iob_cpustats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: iob_alloc_qentry
  *
@@ -132,6 +132,15 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
 
   flags = enter_critical_section();
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* Freed I/O buffers must not be held in a per-CPU cache while we may be
+   * waiting for them.  This must be set before iob_tryalloc() flushes the
+   * caches.
+   */
+
+  g_iob_waiters++;
+#endif
+
   /* Try to get an I/O buffer.  If successful, the semaphore count will be
    * decremented atomically.
    */
@@ -186,56 +195,115 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
         }
     }
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  g_iob_waiters--;
+#endif
+
   leave_critical_section(flags);
   return iob;
 }
 
 /****************************************************************************
- * Public Functions
+ * Name: iob_alloc_large
+ *
+ * Description:
+ *   Allocate a large I/O buffer without waiting.  Large I/O buffers are
+ *   not counted by the IOB semaphores and are never waited for.
+ *
  ****************************************************************************/
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static FAR struct iob_s *iob_alloc_large(enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  iob   = g_iob_largelist;
+  if (iob != NULL)
+    {
+      g_iob_largelist = iob->io_flink;
+    }
+
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onalloc(consumerid);
+#endif
+
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  return iob;
+}
+#endif
+
 /****************************************************************************
- * Name: iob_alloc
+ * Name: iob_tryalloc_list
  *
  * Description:
- *   Allocate an I/O buffer by taking the buffer at the head of the free list.
+ *   Take up to 'count' I/O buffers without waiting, first from the cache of
+ *   this CPU and then from the global free list.  The buffers are added to
+ *   the head of 'list' and are not initialized.
  *
  ****************************************************************************/
 
-FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid)
+static int iob_tryalloc_list(FAR struct iob_s **list, int count,
+                             bool throttled)
 {
-  /* Were we called from the interrupt level? */
+  int n = 0;
 
-  if (up_interrupt_context() || sched_idletask())
-    {
-      /* Yes, then try to allocate an I/O buffer without waiting */
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  n = iob_cache_alloc(list, count);
+#endif
 
-      return iob_tryalloc(throttled, consumerid);
-    }
-  else
+  if (n < count)
     {
-      /* Then allocate an I/O buffer, waiting as necessary */
+      n += iob_pool_alloc(list, count - n, throttled);
 
-      return iob_allocwait(throttled, consumerid);
+#ifdef CONFIG_IOB_PERCPU_CACHE
+      /* The missing I/O buffers may be held in the caches of other CPUs */
+
+      if (n < count && iob_cache_flush())
+        {
+          n += iob_pool_alloc(list, count - n, throttled);
+        }
+#endif
     }
+
+  return n;
 }
 
 /****************************************************************************
- * Name: iob_tryalloc
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_pool_alloc
  *
  * Description:
- *   Try to allocate an I/O buffer by taking the buffer at the head of the
- *   free list without waiting for a buffer to become free.
+ *   Take up to 'count' I/O buffers from the global free list in one
+ *   critical section and add them to the head of 'list'.  The IOB
+ *   semaphore counts are decremented for each buffer.
  *
  ****************************************************************************/
 
-FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
+int iob_pool_alloc(FAR struct iob_s **list, int count, bool throttled)
 {
   FAR struct iob_s *iob;
   irqstate_t flags;
 #if CONFIG_IOB_THROTTLE > 0
   FAR sem_t *sem;
 #endif
+  int n;
 
 #if CONFIG_IOB_THROTTLE > 0
   /* Select the semaphore count to check. */
@@ -249,60 +317,242 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
 
   flags = enter_critical_section();
 
+  for (n = 0; n < count; n++)
+    {
 #if CONFIG_IOB_THROTTLE > 0
-  /* If there are free I/O buffers for this allocation */
+      /* Are there free I/O buffers for this allocation? */
 
-  if (sem->semcount > 0)
+      if (sem->semcount <= 0)
+        {
+          break;
+        }
 #endif
-    {
+
       /* Take the I/O buffer from the head of the free list */
 
       iob = g_iob_freelist;
-      if (iob != NULL)
+      if (iob == NULL)
         {
-          /* Remove the I/O buffer from the free list and decrement the
-           * counting semaphore(s) that tracks the number of available
-           * IOBs.
-           */
+          break;
+        }
 
-          g_iob_freelist = iob->io_flink;
+      /* Remove the I/O buffer from the free list and decrement the
+       * counting semaphore(s) that tracks the number of available
+       * IOBs.
+       */
 
-          /* Take a semaphore count.  Note that we cannot do this in
-           * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-           * because this function may be called from an interrupt
-           * handler. Fortunately we know at at least one free buffer
-           * so a simple decrement is all that is needed.
-           */
+      g_iob_freelist = iob->io_flink;
 
-          g_iob_sem.semcount--;
-          DEBUGASSERT(g_iob_sem.semcount >= 0);
+      /* Take a semaphore count.  Note that we cannot do this in
+       * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
+       * because this function may be called from an interrupt
+       * handler. Fortunately we know at at least one free buffer
+       * so a simple decrement is all that is needed.
+       */
+
+      g_iob_sem.semcount--;
+      DEBUGASSERT(g_iob_sem.semcount >= 0);
 
 #if CONFIG_IOB_THROTTLE > 0
-          /* The throttle semaphore is a little more complicated because
-           * it can be negative!  Decrementing is still safe, however.
-           */
+      /* The throttle semaphore is a little more complicated because
+       * it can be negative!  Decrementing is still safe, however.
+       */
 
-          g_throttle_sem.semcount--;
-          DEBUGASSERT(g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE);
+      g_throttle_sem.semcount--;
+      DEBUGASSERT(g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE);
 #endif
 
+      iob->io_flink = *list;
+      *list         = iob;
+    }
+
+  leave_critical_section(flags);
+  return n;
+}
+
+/****************************************************************************
+ * Name: iob_alloc
+ *
+ * Description:
+ *   Allocate an I/O buffer by taking the buffer at the head of the free list.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid)
+{
+  /* Were we called from the interrupt level? */
+
+  if (up_interrupt_context() || sched_idletask())
+    {
+      /* Yes, then try to allocate an I/O buffer without waiting */
+
+      return iob_tryalloc(throttled, consumerid);
+    }
+  else
+    {
+      /* Then allocate an I/O buffer, waiting as necessary */
+
+      return iob_allocwait(throttled, consumerid);
+    }
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc
+ *
+ * Description:
+ *   Try to allocate an I/O buffer by taking the buffer at the head of the
+ *   free list without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = NULL;
+
+  if (iob_tryalloc_list(&iob, 1, throttled) == 0)
+    {
+      return NULL;
+    }
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
-          iob_stats_onalloc(consumerid);
+  iob_stats_onalloc(consumerid);
 #endif
 
-          leave_critical_section(flags);
+  /* Put the I/O buffer in a known state */
 
-          /* Put the I/O buffer in a known state */
+  iob->io_flink  = NULL; /* Not in a chain */
+  iob->io_len    = 0;    /* Length of the data in the entry */
+  iob->io_offset = 0;    /* Offset to the beginning of data */
+  iob->io_pktlen = 0;    /* Total length of the packet */
+  return iob;
+}
 
-          iob->io_flink  = NULL; /* Not in a chain */
-          iob->io_len    = 0;    /* Length of the data in the entry */
-          iob->io_offset = 0;    /* Offset to the beginning of data */
-          iob->io_pktlen = 0;    /* Total length of the packet */
+/****************************************************************************
+ * Name: iob_alloc_len
+ *
+ * Description:
+ *   Allocate an I/O buffer for 'len' bytes of data.  A large I/O buffer is
+ *   taken if 'len' does not fit in a standard buffer and a large buffer is
+ *   free.  Otherwise, this is the same as iob_alloc().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_len(unsigned int len, bool throttled,
+                                enum iob_user_e consumerid)
+{
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  FAR struct iob_s *iob;
+
+  if (len > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_alloc_large(consumerid);
+      if (iob != NULL)
+        {
           return iob;
         }
     }
+#endif
 
-  leave_critical_section(flags);
-  return NULL;
+  return iob_alloc(throttled, consumerid);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_len
+ *
+ * Description:
+ *   Allocate an I/O buffer for 'len' bytes of data, like iob_alloc_len(),
+ *   but without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_len(unsigned int len, bool throttled,
+                                   enum iob_user_e consumerid)
+{
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  FAR struct iob_s *iob;
+
+  if (len > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_alloc_large(consumerid);
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+#endif
+
+  return iob_tryalloc(throttled, consumerid);
+}
+
+/****************************************************************************
+ * Name: iob_alloc_batch
+ *
+ * Description:
+ *   Allocate 'count' I/O buffers linked into one chain.  As many buffers as
+ *   possible are taken at once from the per-CPU cache and the free list.
+ *   If called from a thread, this waits for the remaining buffers like
+ *   iob_alloc().  Otherwise, the allocation fails if not enough buffers
+ *   are free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_batch(int count, bool throttled,
+                                  enum iob_user_e consumerid)
+{
+  FAR struct iob_s *list = NULL;
+  FAR struct iob_s *iob;
+  int n;
+
+  DEBUGASSERT(count > 0);
+
+  /* Take as many I/O buffers as we can without waiting */
+
+  n = iob_tryalloc_list(&list, count, throttled);
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  for (iob = list; iob != NULL; iob = iob->io_flink)
+    {
+      iob_stats_onalloc(consumerid);
+    }
+#endif
+
+  /* Then wait for the rest, one at a time, if we can */
+
+  while (n < count)
+    {
+      iob = NULL;
+      if (!up_interrupt_context() && !sched_idletask())
+        {
+          iob = iob_allocwait(throttled, consumerid);
+        }
+
+      if (iob == NULL)
+        {
+          /* Release the partial chain */
+
+          if (list != NULL)
+            {
+              iob_free_list(list, consumerid);
+            }
+
+          return NULL;
+        }
+
+      iob->io_flink = list;
+      list          = iob;
+      n++;
+    }
+
+  /* Put each I/O buffer in a known state.  The chain is left linked. */
+
+  for (iob = list; iob != NULL; iob = iob->io_flink)
+    {
+      iob->io_len    = 0;
+      iob->io_offset = 0;
+      iob->io_pktlen = 0;
+    }
+
+  return list;
 }
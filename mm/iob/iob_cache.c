@@ -0,0 +1,375 @@
+/****************************************************************************
+ * mm/iob/iob_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The cache of free I/O buffers of one CPU.  The IOBs in the cache are
+ * counted as allocated by the IOB semaphores.  Only the owning CPU adds or
+ * removes IOBs, except for iob_cache_flush(), so the lock is normally not
+ * contended.
+ */
+
+struct iob_cache_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t lock;            /* Protects against iob_cache_flush() */
+#endif
+  FAR struct iob_s *head;     /* List of cached IOBs */
+  int count;                  /* Number of IOBs in the list */
+  int hits;                   /* IOBs allocated from the cache */
+  int refills;                /* Batches taken from the global free list */
+  int drains;                 /* Batches returned to the global free list */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The number of threads that may be waiting for a free IOB */
+
+volatile int g_iob_waiters;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_cache_s g_iob_cache[IOB_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_lock
+ *
+ * Description:
+ *   Disable local interrupts and return the cache of this CPU.  In the SMP
+ *   case, the cache is also locked against a flush from another CPU.
+ *
+ ****************************************************************************/
+
+static inline FAR struct iob_cache_s *iob_cache_lock(FAR irqstate_t *flags)
+{
+  FAR struct iob_cache_s *cache;
+
+  *flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  cache = &g_iob_cache[up_cpu_index()];
+  spin_lock(&cache->lock);
+#else
+  cache = &g_iob_cache[0];
+#endif
+
+  return cache;
+}
+
+/****************************************************************************
+ * Name: iob_cache_unlock
+ ****************************************************************************/
+
+static inline void iob_cache_unlock(FAR struct iob_cache_s *cache,
+                                    irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&cache->lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: iob_cache_take
+ *
+ * Description:
+ *   Move up to 'count' IOBs from the cache to the head of 'list'.  The
+ *   cache must be locked.
+ *
+ ****************************************************************************/
+
+static int iob_cache_take(FAR struct iob_cache_s *cache,
+                          FAR struct iob_s **list, int count)
+{
+  FAR struct iob_s *iob;
+  int n;
+
+  for (n = 0; n < count && cache->head != NULL; n++)
+    {
+      iob           = cache->head;
+      cache->head   = iob->io_flink;
+      iob->io_flink = *list;
+      *list         = iob;
+    }
+
+  cache->count -= n;
+  cache->hits  += n;
+  return n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Take up to 'count' I/O buffers from the cache of this CPU and add them
+ *   to the head of 'list'.  An empty cache is refilled from the global free
+ *   list in one batch.
+ *
+ ****************************************************************************/
+
+int iob_cache_alloc(FAR struct iob_s **list, int count)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *refill = NULL;
+  FAR struct iob_s *tail;
+  irqstate_t flags;
+  int nrefill;
+  int n;
+
+  cache = iob_cache_lock(&flags);
+  n     = iob_cache_take(cache, list, count);
+  iob_cache_unlock(cache, flags);
+
+  /* Don't refill while a thread may be waiting for a free IOB */
+
+  if (n == count || g_iob_waiters > 0)
+    {
+      return n;
+    }
+
+  /* Refill from the global free list in one batch.  The global critical
+   * section must never be entered with the cache locked since
+   * iob_cache_flush() takes the cache locks from within it.
+   *
+   * Only IOBs above the throttle limit are taken so that any allocation
+   * may be served from the cache.  The reserved IOBs stay in the free list
+   * for unthrottled allocations.
+   */
+
+  nrefill = iob_pool_alloc(&refill, count - n + CONFIG_IOB_PERCPU_BATCH,
+                           true);
+  if (nrefill == 0)
+    {
+      return n;
+    }
+
+  for (tail = refill; tail->io_flink != NULL; tail = tail->io_flink);
+
+  cache = iob_cache_lock(&flags);
+
+  tail->io_flink = cache->head;
+  cache->head    = refill;
+  cache->count  += nrefill;
+  cache->refills++;
+
+  n += iob_cache_take(cache, list, count - n);
+
+  iob_cache_unlock(cache, flags);
+  return n;
+}
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Add a NULL terminated list of I/O buffers to the cache of this CPU.  If
+ *   the cache overflows, the oldest buffers are drained in one batch.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_free(FAR struct iob_s *list)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *drain = NULL;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int keep;
+
+  cache = iob_cache_lock(&flags);
+
+  /* A thread that may wait for an IOB increments g_iob_waiters before it
+   * flushes the caches.  Checking it with the cache locked assures that
+   * the freed IOBs are either flushed or given to the free list.
+   */
+
+  if (g_iob_waiters > 0)
+    {
+      iob_cache_unlock(cache, flags);
+      return list;
+    }
+
+  while (list != NULL)
+    {
+      iob           = list;
+      list          = iob->io_flink;
+      iob->io_flink = cache->head;
+      cache->head   = iob;
+      cache->count++;
+    }
+
+  /* On overflow, keep the most recently freed IOBs, which are likely to be
+   * still in the data cache, and drain the rest.
+   */
+
+  if (cache->count > CONFIG_IOB_PERCPU_DEPTH)
+    {
+      keep = CONFIG_IOB_PERCPU_DEPTH - CONFIG_IOB_PERCPU_BATCH;
+      if (keep == 0)
+        {
+          drain       = cache->head;
+          cache->head = NULL;
+        }
+      else
+        {
+          for (iob = cache->head; --keep > 0; iob = iob->io_flink);
+
+          drain         = iob->io_flink;
+          iob->io_flink = NULL;
+        }
+
+      cache->count = CONFIG_IOB_PERCPU_DEPTH - CONFIG_IOB_PERCPU_BATCH;
+      cache->drains++;
+    }
+
+  iob_cache_unlock(cache, flags);
+  return drain;
+}
+
+/****************************************************************************
+ * Name: iob_cache_flush
+ *
+ * Description:
+ *   Return the I/O buffers in the caches of all CPUs to the global free
+ *   list.  This is done when an allocation cannot otherwise be satisfied.
+ *
+ ****************************************************************************/
+
+bool iob_cache_flush(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *list = NULL;
+  FAR struct iob_s *tail;
+  irqstate_t flags;
+  int cpu;
+
+  /* Detach all of the cached IOBs.  No CPU holds its own cache lock for
+   * long, so this may be called from within the global critical section.
+   */
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      cache = &g_iob_cache[cpu];
+      flags = up_irq_save();
+#ifdef CONFIG_SMP
+      spin_lock(&cache->lock);
+#endif
+
+      if (cache->head != NULL)
+        {
+          for (tail = cache->head; tail->io_flink != NULL;
+               tail = tail->io_flink);
+
+          tail->io_flink = list;
+          list           = cache->head;
+          cache->head    = NULL;
+          cache->count   = 0;
+          cache->drains++;
+        }
+
+#ifdef CONFIG_SMP
+      spin_unlock(&cache->lock);
+#endif
+      up_irq_restore(flags);
+    }
+
+  if (list == NULL)
+    {
+      return false;
+    }
+
+  iob_pool_free(list);
+  return true;
+}
+
+/****************************************************************************
+ * Name: iob_cache_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers held in the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+int iob_cache_navail(void)
+{
+  int navail = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      navail += g_iob_cache[cpu].count;
+    }
+
+  return navail;
+}
+
+/****************************************************************************
+ * Name: iob_cache_stats
+ *
+ * Description:
+ *   Add the cache statistics of one CPU to 'stats'.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_cache_stats(int cpu, FAR struct iob_cpustats_s *stats)
+{
+  FAR struct iob_cache_s *cache = &g_iob_cache[cpu];
+
+  stats->cached  += cache->count;
+  stats->hits    += cache->hits;
+  stats->refills += cache->refills;
+  stats->drains  += cache->drains;
+}
+#endif
+
+#endif /* CONFIG_IOB_PERCPU_CACHE */
@@ -78,6 +78,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled,
   unsigned int avail2;
   unsigned int offset1;
   unsigned int offset2;
+  unsigned int remaining;
 
   DEBUGASSERT(iob2->io_len == 0 && iob2->io_offset == 0 &&
               iob2->io_pktlen == 0 && iob2->io_flink == NULL);
@@ -87,6 +88,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled,
    */
 
   iob2->io_pktlen = iob1->io_pktlen;
+  remaining       = iob1->io_pktlen;
 
   /* Handle special case where there are empty buffers at the head
    * the list.
@@ -116,7 +118,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled,
        */
 
       dest   = &iob2->io_data[offset2];
-      avail2 = CONFIG_IOB_BUFSIZE - offset2;
+      avail2 = IOB_BUFSIZE(iob2) - offset2;
 
       /* Copy the smaller of the two and update the srce and destination
        * offsets.
@@ -125,6 +127,8 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled,
       ncopy = MIN(avail1, avail2);
       memcpy(dest, src, ncopy);
 
+      remaining = remaining > ncopy ? remaining - ncopy : 0;
+
       offset1 += ncopy;
       offset2 += ncopy;
 
@@ -153,15 +157,16 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled,
        * transferred?
        */
 
-      if (offset2 >= CONFIG_IOB_BUFSIZE && iob1 != NULL)
+      if (offset2 >= IOB_BUFSIZE(iob2) && iob1 != NULL)
         {
           FAR struct iob_s *next;
 
-          /* Allocate new destination I/O buffer and hook it into the
-           * destination I/O buffer chain.
+          /* Allocate new destination I/O buffer, sized for the remaining
+           * data if possible, and hook it into the destination I/O buffer
+           * chain.
            */
 
-          next = iob_alloc(throttled, consumerid);
+          next = iob_alloc_len(remaining, throttled, consumerid);
           if (!next)
             {
               ioberr("ERROR: Failed to allocate an I/O buffer\n");
@@ -74,61 +74,83 @@
 #define IOB_MASK      (IOB_DIVIDER - 1)
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: iob_free
+ * Name: iob_free_large
  *
  * Description:
- *   Free the I/O buffer at the head of a buffer chain returning it to the
- *   free list.  The link to  the next I/O buffer in the chain is return.
+ *   Return the large I/O buffers in a list to their own free list and
+ *   return the list of the remaining standard I/O buffers.
  *
  ****************************************************************************/
 
-FAR struct iob_s *iob_free(FAR struct iob_s *iob,
-                           enum iob_user_e producerid)
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static FAR struct iob_s *iob_free_large(FAR struct iob_s *list)
 {
-  FAR struct iob_s *next = iob->io_flink;
+  FAR struct iob_s *small = NULL;
+  FAR struct iob_s *large = NULL;
+  FAR struct iob_s *tail  = NULL;
+  FAR struct iob_s *iob;
   irqstate_t flags;
-#ifdef CONFIG_IOB_NOTIFIER
-  int16_t navail;
-#endif
 
-  iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
-          iob, iob->io_pktlen, iob->io_len, next);
-
-  /* Copy the data that only exists in the head of a I/O buffer chain into
-   * the next entry.
-   */
-
-  if (next != NULL)
+  while (list != NULL)
     {
-      /* Copy and decrement the total packet length, being careful to
-       * do nothing too crazy.
-       */
+      iob  = list;
+      list = iob->io_flink;
 
-      if (iob->io_pktlen > iob->io_len)
+      if (iob->io_bufsize > CONFIG_IOB_BUFSIZE)
         {
-          /* Adjust packet length and move it to the next entry */
+          DEBUGASSERT(iob->io_bufsize == CONFIG_IOB_LARGE_BUFSIZE);
 
-          next->io_pktlen = iob->io_pktlen - iob->io_len;
-          DEBUGASSERT(next->io_pktlen >= next->io_len);
+          if (large == NULL)
+            {
+              tail = iob;
+            }
+
+          iob->io_flink = large;
+          large         = iob;
         }
       else
         {
-          /* This can only happen if the free entry isn't first entry in the
-           * chain...
-           */
-
-          next->io_pktlen = 0;
+          iob->io_flink = small;
+          small         = iob;
         }
+    }
 
-      iobinfo("next=%p io_pktlen=%u io_len=%u\n",
-              next, next->io_pktlen, next->io_len);
+  if (large != NULL)
+    {
+      flags           = enter_critical_section();
+      tail->io_flink  = g_iob_largelist;
+      g_iob_largelist = large;
+      leave_critical_section(flags);
     }
 
-  /* Free the I/O buffer by adding it to the head of the free or the
+  return small;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_pool_free
+ *
+ * Description:
+ *   Return a NULL terminated list of I/O buffers to the global free list,
+ *   or to the committed list if there are waiters, in one critical section.
+ *   The IOB semaphores are posted for each buffer.
+ *
+ ****************************************************************************/
+
+void iob_pool_free(FAR struct iob_s *list)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  /* Free the I/O buffers by adding them to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
    * interrupts very briefly.
@@ -136,43 +158,95 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 
   flags = enter_critical_section();
 
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
-   */
-
-  if (g_iob_sem.semcount < 0)
-    {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-    }
-  else
+  while (list != NULL)
     {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
+      iob  = list;
+      list = iob->io_flink;
+
+      /* Which list?  If there is a task waiting for an IOB, then put
+       * the IOB on either the free list or on the committed list where
+       * it is reserved for that allocation (and not available to
+       * iob_tryalloc()).
+       */
+
+      if (g_iob_sem.semcount < 0)
+        {
+          iob->io_flink   = g_iob_committed;
+          g_iob_committed = iob;
+        }
+      else
+        {
+          iob->io_flink   = g_iob_freelist;
+          g_iob_freelist  = iob;
+        }
+
+      /* Signal that an IOB is available.  If there is a thread blocked,
+       * waiting for an IOB, this will wake up exactly one thread.  The
+       * semaphore count will correctly indicated that the awakened task
+       * owns an IOB and should find it in the committed list.
+       */
+
+      nxsem_post(&g_iob_sem);
+      DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+
+#if CONFIG_IOB_THROTTLE > 0
+      nxsem_post(&g_throttle_sem);
+      DEBUGASSERT(g_throttle_sem.semcount <=
+                  (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+#endif
     }
 
-  /* Signal that an IOB is available.  If there is a thread blocked,
-   * waiting for an IOB, this will wake up exactly one thread.  The
-   * semaphore count will correctly indicated that the awakened task
-   * owns an IOB and should find it in the committed list.
-   */
+  leave_critical_section(flags);
+}
 
-  nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Free a NULL terminated list of I/O buffers, through the per-CPU cache
+ *   if it is enabled.  This is common logic for iob_free() and
+ *   iob_free_chain().
+ *
+ ****************************************************************************/
 
+void iob_free_list(FAR struct iob_s *list, enum iob_user_e producerid)
+{
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
-  iob_stats_onfree(producerid);
+  FAR struct iob_s *iob;
+#endif
+#ifdef CONFIG_IOB_NOTIFIER
+  int16_t navail;
 #endif
 
-#if CONFIG_IOB_THROTTLE > 0
-  nxsem_post(&g_throttle_sem);
-  DEBUGASSERT(g_throttle_sem.semcount <=
-              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  for (iob = list; iob != NULL; iob = iob->io_flink)
+    {
+      iob_stats_onfree(producerid);
+    }
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  /* Large I/O buffers have their own free list and are not cached */
+
+  list = iob_free_large(list);
 #endif
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* Keep what we can in the cache of this CPU */
+
+  if (list != NULL)
+    {
+      list = iob_cache_free(list);
+    }
+#endif
+
+  if (list != NULL)
+    {
+      iob_pool_free(list);
+    }
+
 #ifdef CONFIG_IOB_NOTIFIER
   /* Check if the IOB was claimed by a thread that is blocked waiting
    * for an IOB.
@@ -188,8 +262,59 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
       iob_notifier_signal();
     }
 #endif
+}
 
-  leave_critical_section(flags);
+/****************************************************************************
+ * Name: iob_free
+ *
+ * Description:
+ *   Free the I/O buffer at the head of a buffer chain returning it to the
+ *   free list.  The link to  the next I/O buffer in the chain is return.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_free(FAR struct iob_s *iob,
+                           enum iob_user_e producerid)
+{
+  FAR struct iob_s *next = iob->io_flink;
+
+  iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
+          iob, iob->io_pktlen, iob->io_len, next);
+
+  /* Copy the data that only exists in the head of a I/O buffer chain into
+   * the next entry.
+   */
+
+  if (next != NULL)
+    {
+      /* Copy and decrement the total packet length, being careful to
+       * do nothing too crazy.
+       */
+
+      if (iob->io_pktlen > iob->io_len)
+        {
+          /* Adjust packet length and move it to the next entry */
+
+          next->io_pktlen = iob->io_pktlen - iob->io_len;
+          DEBUGASSERT(next->io_pktlen >= next->io_len);
+        }
+      else
+        {
+          /* This can only happen if the free entry isn't first entry in the
+           * chain...
+           */
+
+          next->io_pktlen = 0;
+        }
+
+      iobinfo("next=%p io_pktlen=%u io_len=%u\n",
+              next, next->io_pktlen, next->io_len);
+    }
+
+  /* Free the I/O buffer alone */
+
+  iob->io_flink = NULL;
+  iob_free_list(iob, producerid);
 
   /* And return the I/O buffer after the one that was freed */
 
@@ -59,12 +59,13 @@
 
 void iob_free_chain(FAR struct iob_s *iob, enum iob_user_e producerid)
 {
-  FAR struct iob_s *next;
+  /* The whole chain is freed so there is no packet length to carry over to
+   * the next entry.  Free all of the IOBs at once to keep the count
+   * straight without taking the free list once per IOB.
+   */
 
-  /* Free each IOB in the chain -- one at a time to keep the count straight */
-
-  for (; iob; iob = next)
+  if (iob != NULL)
     {
-      next = iob_free(iob, producerid);
+      iob_free_list(iob, producerid);
     }
 }
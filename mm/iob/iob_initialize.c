@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <stdbool.h>
 
 #include <nuttx/mm/iob.h>
@@ -60,6 +61,16 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static uint8_t             g_iob_data[CONFIG_IOB_NBUFFERS]
+                                     [CONFIG_IOB_BUFSIZE];
+
+/* And the pool of pre-allocated large I/O buffers */
+
+static struct iob_s        g_iob_largepool[CONFIG_IOB_LARGE_NBUFFERS];
+static uint8_t             g_iob_largedata[CONFIG_IOB_LARGE_NBUFFERS]
+                                          [CONFIG_IOB_LARGE_BUFSIZE];
+#endif
 #if CONFIG_IOB_NCHAINS > 0
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
@@ -76,6 +87,12 @@ FAR struct iob_s *g_iob_freelist;
 
 FAR struct iob_s *g_iob_committed;
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* A list of all free, unallocated large I/O buffers */
+
+FAR struct iob_s *g_iob_largelist;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -123,6 +140,11 @@ void iob_initialize(void)
         {
           FAR struct iob_s *iob = &g_iob_pool[i];
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+          iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+          iob->io_data    = g_iob_data[i];
+#endif
+
           /* Add the pre-allocate I/O buffer to the head of the free list */
 
           iob->io_flink  = g_iob_freelist;
@@ -131,6 +153,20 @@ void iob_initialize(void)
 
       g_iob_committed = NULL;
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+      /* Add each large I/O buffer to its own free list */
+
+      for (i = 0; i < CONFIG_IOB_LARGE_NBUFFERS; i++)
+        {
+          FAR struct iob_s *iob = &g_iob_largepool[i];
+
+          iob->io_bufsize = CONFIG_IOB_LARGE_BUFSIZE;
+          iob->io_data    = g_iob_largedata[i];
+          iob->io_flink   = g_iob_largelist;
+          g_iob_largelist = iob;
+        }
+#endif
+
       nxsem_init(&g_iob_sem, 0, CONFIG_IOB_NBUFFERS);
 #if CONFIG_IOB_THROTTLE > 0
       nxsem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
@@ -83,6 +83,14 @@ int iob_navail(bool throttled)
         {
           ret = 0;
         }
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+      /* The IOBs in the per-CPU caches are also available, even for a
+       * throttled allocation.
+       */
+
+      ret += iob_cache_navail();
+#endif
     }
 
 #else
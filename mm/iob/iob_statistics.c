@@ -42,10 +42,16 @@
 #include <sys/types.h>
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <assert.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
 #include <nuttx/mm/iob.h>
 
+#include "iob.h"
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
 
@@ -53,7 +59,32 @@
  * Private Data
  ****************************************************************************/
 
-struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
+/* The statistics are kept per CPU so that they can be updated without the
+ * global critical section.
+ */
+
+static struct iob_userstats_s g_iobuserstats[IOB_NCPUS][IOBUSER_NENTRIES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_stats_cpu
+ *
+ * Description:
+ *   Return the statistics of this CPU.  Local interrupts must be disabled.
+ *
+ ****************************************************************************/
+
+static inline FAR struct iob_userstats_s *iob_stats_cpu(void)
+{
+#ifdef CONFIG_SMP
+  return g_iobuserstats[up_cpu_index()];
+#else
+  return g_iobuserstats[0];
+#endif
+}
 
 /****************************************************************************
  * Public Functions
@@ -76,12 +107,19 @@ struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
 
 void iob_stats_onalloc(enum iob_user_e consumerid)
 {
+  FAR struct iob_userstats_s *stats;
+  irqstate_t flags;
+
   DEBUGASSERT(consumerid < IOBUSER_NENTRIES);
-  g_iobuserstats[consumerid].totalconsumed++;
+
+  flags = up_irq_save();
+  stats = iob_stats_cpu();
+  stats[consumerid].totalconsumed++;
 
   /* Increment the global statistic as well */
 
-  g_iobuserstats[IOBUSER_GLOBAL].totalconsumed++;
+  stats[IOBUSER_GLOBAL].totalconsumed++;
+  up_irq_restore(flags);
 }
 
 /****************************************************************************
@@ -101,32 +139,121 @@ void iob_stats_onalloc(enum iob_user_e consumerid)
 
 void iob_stats_onfree(enum iob_user_e producerid)
 {
+  FAR struct iob_userstats_s *stats;
+  irqstate_t flags;
+
   DEBUGASSERT(producerid < IOBUSER_NENTRIES);
-  g_iobuserstats[producerid].totalproduced++;
+
+  flags = up_irq_save();
+  stats = iob_stats_cpu();
+  stats[producerid].totalproduced++;
 
   /* Increment the global statistic as well */
 
-  g_iobuserstats[IOBUSER_GLOBAL].totalproduced++;
+  stats[IOBUSER_GLOBAL].totalproduced++;
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: iob_stats_handover
+ *
+ * Description:
+ *   An IOB is handed over from one user to another without being freed and
+ *   allocated again.  It is accounted as freed by the producer and as
+ *   allocated by the consumer.  The global statistics do not change.
+ *
+ * Input Parameters:
+ *   producerid - id representing the user that gives up the IOB
+ *   consumerid - id representing the user that takes the IOB
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_stats_handover(enum iob_user_e producerid,
+                        enum iob_user_e consumerid)
+{
+  FAR struct iob_userstats_s *stats;
+  irqstate_t flags;
+
+  DEBUGASSERT(producerid < IOBUSER_NENTRIES &&
+              consumerid < IOBUSER_NENTRIES);
+
+  flags = up_irq_save();
+  stats = iob_stats_cpu();
+  stats[producerid].totalproduced++;
+  stats[consumerid].totalconsumed++;
+  up_irq_restore(flags);
 }
 
 /****************************************************************************
  * Name: iob_getuserstats
  *
  * Description:
- *   Return a reference to the IOB usage statistics for the IOB consumer/producer
+ *   Return the IOB usage statistics for the IOB consumer/producer, summed
+ *   over all CPUs.
  *
  * Input Parameters:
  *   userid - id representing the IOB producer/consumer
+ *   stats  - Location to return the statistics
  *
  * Returned Value:
  *   None.
  *
  ****************************************************************************/
 
-FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid)
+void iob_getuserstats(enum iob_user_e userid,
+                      FAR struct iob_userstats_s *stats)
 {
-  DEBUGASSERT(userid < IOBUSER_NENTRIES);
-  return &g_iobuserstats[userid];
+  int cpu;
+
+  DEBUGASSERT(userid < IOBUSER_NENTRIES && stats != NULL);
+
+  stats->totalconsumed = 0;
+  stats->totalproduced = 0;
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      stats->totalconsumed += g_iobuserstats[cpu][userid].totalconsumed;
+      stats->totalproduced += g_iobuserstats[cpu][userid].totalproduced;
+    }
+}
+
+/****************************************************************************
+ * Name: iob_getcpustats
+ *
+ * Description:
+ *   Return the IOB usage statistics of one CPU.
+ *
+ * Input Parameters:
+ *   cpu   - The CPU index
+ *   stats - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if 'cpu' is not
+ *   a valid CPU index.
+ *
+ ****************************************************************************/
+
+int iob_getcpustats(int cpu, FAR struct iob_cpustats_s *stats)
+{
+  DEBUGASSERT(stats != NULL);
+
+  if (cpu < 0 || cpu >= IOB_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  memset(stats, 0, sizeof(struct iob_cpustats_s));
+  stats->totalconsumed = g_iobuserstats[cpu][IOBUSER_GLOBAL].totalconsumed;
+  stats->totalproduced = g_iobuserstats[cpu][IOBUSER_GLOBAL].totalproduced;
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  iob_cache_stats(cpu, stats);
+#endif
+
+  return OK;
 }
 
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+#include <strings.h>
 #include <assert.h>
 
 #include <nuttx/mm/gran.h>
@@ -32,6 +34,40 @@
 
 #ifdef CONFIG_GRAN
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_update_hint
+ *
+ * Description:
+ *   Advance the free hint past the GAT entries that are fully allocated.
+ *   Since all GAT entries below the hint are fully allocated, no
+ *   allocation can start below it.
+ *
+ * Input Parameters:
+ *   priv - The granule heap state structure.
+ *
+ * Returned Value:
+ *   The index of the first GAT entry that may have a free granule.
+ *
+ ****************************************************************************/
+
+static inline unsigned int gran_update_hint(FAR struct gran_s *priv)
+{
+  unsigned int ngat   = SIZEOF_GAT(priv->ngranules);
+  unsigned int gatidx = priv->freehint;
+
+  while (gatidx < ngat && priv->gat[gatidx] == 0xffffffff)
+    {
+      gatidx++;
+    }
+
+  priv->freehint = gatidx;
+  return gatidx;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -60,13 +96,14 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
 {
   FAR struct gran_s *priv = (FAR struct gran_s *)handle;
   unsigned int ngranules;
+  unsigned int ngat;
+  unsigned int gatidx;
   size_t       tmpmask;
   uintptr_t    alloc;
-  uint32_t     curr;
-  uint32_t     next;
+  uint64_t     window;
   uint32_t     mask;
+  uint32_t     inuse;
   int          granidx;
-  int          gatidx;
   int          bitidx;
   int          shift;
   int          ret;
@@ -93,149 +130,119 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
       DEBUGASSERT(ngranules <= 32);
       mask = 0xffffffff >> (32 - ngranules);
 
-      /* Now search the granule allocation table for that number of contiguous */
+      /* Skip the GAT entries that are known to be full */
+
+      ngat   = SIZEOF_GAT(priv->ngranules);
+      gatidx = gran_update_hint(priv);
 
-      for (granidx = 0; granidx < priv->ngranules; granidx += 32)
+      /* A single granule is simply the first free granule at the hint */
+
+      if (ngranules == 1)
         {
-          /* Get the GAT index associated with the granule table entry */
+          if (gatidx < ngat)
+            {
+              granidx = (gatidx << 5) + ffs((int)~priv->gat[gatidx]) - 1;
+              if (granidx < priv->ngranules)
+                {
+                  priv->gat[gatidx] |= (uint32_t)1 << (granidx & 31);
+                  alloc = priv->heapstart +
+                          ((uintptr_t)granidx << priv->log2gran);
 
-          gatidx = granidx >> 5;
-          curr = priv->gat[gatidx];
+                  gran_leave_critical(priv);
+                  return (FAR void *)alloc;
+                }
+            }
+
+          gran_leave_critical(priv);
+          return NULL;
+        }
 
+      /* Now search the granule allocation table for that number of
+       * contiguous free granules, one GAT entry at a time.
+       */
+
+      for (; gatidx < ngat; gatidx++)
+        {
           /* Handle the case where there are no free granules in the entry */
 
-          if (curr == 0xffffffff)
+          if (priv->gat[gatidx] == 0xffffffff)
             {
               continue;
             }
 
-          /* Get the next entry from the GAT to support a 64 bit shift */
+          /* Load this entry and the next entry from the GAT into a 64 bit
+           * window so that an allocation may span both of them.  Use all
+           * ones past the last entry in the GAT (meaning nothing can be
+           * allocated there).
+           */
 
-          if (granidx < priv->ngranules)
+          window = priv->gat[gatidx];
+          if (gatidx + 1 < ngat)
             {
-              next = priv->gat[gatidx + 1];
+              window |= (uint64_t)priv->gat[gatidx + 1] << 32;
             }
-
-          /* Use all ones when are at the last entry in the GAT (meaning
-           * nothing can be allocated.
-           */
-
           else
             {
-              next = 0xffffffff;
+              window |= (uint64_t)0xffffffff << 32;
             }
 
-          /* Search through the allocations in the 'curr' GAT entry
-           * to see if we can satisfy the allocation starting in that
-           * entry.
+          /* Search through the allocations in the GAT entry to see if we
+           * can satisfy the allocation starting in that entry.
            *
            * This loop continues until either all of the bits have been
            * examined (bitidx >= 32), or until there are insufficient
            * granules left to satisfy the allocation.
            */
 
-          alloc = priv->heapstart + (granidx << priv->log2gran);
-
+          granidx = gatidx << 5;
           for (bitidx = 0;
                bitidx < 32 &&
                (granidx + bitidx + ngranules) <= priv->ngranules;
               )
             {
-              /* Break out if there are no further free bits in 'curr'.
+              /* Break out if there are no further free bits in the entry.
                * All of the zero bits might have gotten shifted out.
                */
 
-              if (curr == 0xffffffff)
+              if ((uint32_t)window == 0xffffffff)
                 {
                   break;
                 }
 
-              /* Check for the first zero bit in the lower or upper 16-bits.
-               * From the test above, we know that at least one of the 32-
-               * bits in 'curr' is zero.
-               */
+              /* Find the first free granule */
 
-              else if ((curr & 0x0000ffff) == 0x0000ffff)
+              shift = ffs((int)~(uint32_t)window) - 1;
+              if (shift == 0)
                 {
-                  /* Not in the lower 16 bits.  The first free bit must be
-                   * in the upper 16 bits.
-                   */
+                  /* Check if we have the allocation at this position */
 
-                  shift = 16;
-                }
-
-              /* We know that the first free bit is now within the lower 16
-               * bits of 'curr'.  Is it in the upper or lower byte?
-               */
+                  inuse = (uint32_t)window & mask;
+                  if (inuse == 0)
+                    {
+                      /* Yes.. mark these granules allocated */
 
-              else if ((curr & 0x0000ff) == 0x000000ff)
-                {
-                  /* Not in the lower 8 bits.  The first free bit must be in
-                   * the upper 8 bits.
-                   */
+                      alloc = priv->heapstart +
+                              ((uintptr_t)(granidx + bitidx) <<
+                               priv->log2gran);
+                      gran_mark_allocated(priv, alloc, ngranules);
 
-                  shift = 8;
-                }
+                      /* And return the allocation address */
 
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower nibble?
-               */
+                      gran_leave_critical(priv);
+                      return (FAR void *)alloc;
+                    }
 
-              else if ((curr & 0x00000f) == 0x0000000f)
-                {
-                  /* Not in the lower 4 bits.  The first free bit must be in
-                   * the upper 4 bits.
+                  /* No.. no allocation can start at or before the first
+                   * allocated granule within the mask.  Skip past it.
                    */
 
-                  shift = 4;
+                  shift = ffs((int)inuse);
                 }
 
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower pair?
-               */
-
-              else if ((curr & 0x000003) == 0x00000003)
-                {
-                  /* Not in the lower 2 bits.  The first free bit must be in
-                   * the upper 2 bits.
-                   */
-
-                  shift = 2;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Check if we have the allocation at this
-               * bit position.
-               */
-
-              else if ((curr & mask) == 0)
-                {
-                  /* Yes.. mark these granules allocated */
-
-                  gran_mark_allocated(priv, alloc, ngranules);
-
-                  /* And return the allocation address */
-
-                  gran_leave_critical(priv);
-                  return (FAR void *)alloc;
-                }
-
-              /* The free allocation does not start at this position */
-
-              else
-                {
-                  shift = 1;
-                }
-
-              /* Set up for the next time through the loop.  Perform a 64
-               * bit shift to move to the next gran position and increment
-               * to the next candidate allocation address.
-               */
+              /* Set up for the next time through the loop */
 
-              alloc  += (shift << priv->log2gran);
-              curr    = (curr >> shift) | (next << (32 - shift));
-              next  >>= shift;
-              bitidx += shift;
+              window >>= shift;
+              bitidx  += shift;
             }
         }
 
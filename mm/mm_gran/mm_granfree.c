@@ -129,6 +129,13 @@ void gran_free(GRAN_HANDLE handle, FAR void *memory, size_t size)
       priv->gat[gatidx] &= ~gatmask;
     }
 
+  /* The first GAT entry of the allocation now has free granules */
+
+  if (gatidx < priv->freehint)
+    {
+      priv->freehint = gatidx;
+    }
+
   gran_leave_critical(priv);
 }
 
@@ -121,8 +121,8 @@ void mm_extend(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
   mm_givesemaphore(heap);
 
   /* Finally "free" the new block of memory where the old terminal node was
-   * located.
+   * located.  It never belonged to any task and must not be cached.
    */
 
-  mm_free(heap, (FAR void *)mem);
+  mm_freechunk(heap, (FAR void *)mem);
 }
@@ -71,15 +71,16 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_free
+ * Name: mm_freechunk
  *
  * Description:
  *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   adjacent free chunks if possible.  Unlike mm_free(), the chunk is never
+ *   placed in a size class cache.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
@@ -87,14 +88,6 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   int ret;
 
   UNUSED(ret);
-  minfo("Freeing %p\n", mem);
-
-  /* Protect against attempts to free a NULL reference */
-
-  if (!mem)
-    {
-      return;
-    }
 
 #if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
   /* Check current environment */
@@ -158,16 +151,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       andbeyond = (FAR struct mm_allocnode_s *)
                     ((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -185,16 +171,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -208,3 +187,41 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   mm_addfreechunk(heap, node);
   mm_givesemaphore(heap);
 }
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the size class cache of this CPU or, if
+ *   the chunk cannot be cached, to the list of free nodes.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+#ifdef MM_HAVE_PROFILE
+  /* Remove the chunk from the heap totals of its owner */
+
+  mm_profile_free(heap, mem);
+#endif
+
+#ifdef MM_HAVE_SIZECLASS
+  /* Small chunks are cached for reuse without taking the semaphore */
+
+  if (mm_sizeclass_free(heap, mem))
+    {
+      return;
+    }
+#endif
+
+  mm_freechunk(heap, mem);
+}
@@ -151,7 +151,9 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
                    size_t heapsize)
 {
+#ifndef CONFIG_MM_TLSF_MANAGER
   int i;
+#endif
 
   minfo("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -179,6 +181,19 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   heap->mm_delaylist = NULL;
 
+#ifdef CONFIG_MM_SIZECLASS
+  /* Initialize the size class caches.  All are empty and unlocked. */
+
+  memset(heap->mm_sizeclass, 0, sizeof(heap->mm_sizeclass));
+#endif
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+  /* Initialize the TLSF free lists.  All are empty. */
+
+  heap->mm_flmap = 0;
+  memset(heap->mm_slmap, 0, sizeof(heap->mm_slmap));
+  memset(heap->mm_freelist, 0, sizeof(heap->mm_freelist));
+#else
   /* Initialize the node array */
 
   memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
@@ -187,6 +202,7 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
       heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
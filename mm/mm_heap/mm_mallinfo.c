@@ -67,6 +67,9 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
   int    ordblks  = 0;  /* Number of non-inuse chunks */
   size_t uordblks = 0;  /* Total allocated space */
   size_t fordblks = 0;  /* Total non-inuse space */
+#ifdef MM_HAVE_SIZECLASS
+  size_t cached;
+#endif
 #if CONFIG_MM_REGIONS > 1
   int region;
 #else
@@ -113,6 +116,14 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
               FAR struct mm_freenode_s *fnode = (FAR void *)node;
 #endif
               DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+#ifdef CONFIG_MM_TLSF_MANAGER
+              /* TLSF free lists are not ordered and have no list heads */
+
+              DEBUGASSERT(fnode->blink == NULL ||
+                          fnode->blink->flink == fnode);
+              DEBUGASSERT(fnode->flink == NULL ||
+                          fnode->flink->blink == fnode);
+#else
               DEBUGASSERT(fnode->blink->flink == fnode);
               DEBUGASSERT(fnode->blink->size <= fnode->size);
               DEBUGASSERT(fnode->flink == NULL ||
@@ -120,6 +131,7 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
               DEBUGASSERT(fnode->flink == NULL ||
                           fnode->flink->size == 0 ||
                           fnode->flink->size >= fnode->size);
+#endif
               ordblks++;
               fordblks += node->size;
               if (node->size > mxordblk)
@@ -147,6 +159,16 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 
   DEBUGASSERT(uordblks + fordblks == heap->mm_heapsize);
 
+#ifdef MM_HAVE_SIZECLASS
+  /* Chunks in the size class caches are marked as allocated in the heap,
+   * but they are not in use.
+   */
+
+  ordblks  += mm_sizeclass_info(heap, &cached);
+  uordblks -= cached;
+  fordblks += cached;
+#endif
+
   info->arena    = heap->mm_heapsize;
   info->ordblks  = ordblks;
   info->mxordblk = mxordblk;
@@ -86,108 +86,44 @@ static void mm_free_delaylist(FAR struct mm_heap_s *heap)
       tmp = tmp->flink;
 
       /* The address should always be non-NULL since that was checked in the
-       * 'while' condition above.
+       * 'while' condition above.  The chunk has already been through
+       * mm_free().
        */
 
-      mm_free(heap, address);
+      mm_freechunk(heap, address);
     }
 #endif
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
+ *  Find the smallest free chunk of at least 'alignsize' bytes, split it if
+ *  necessary and mark it as allocated.
  *
- *  8-byte alignment of the allocated data is assured.
+ * Assumptions:
+ *  The caller holds the MM semaphore.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+static FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
-  void *ret = NULL;
-  int ndx;
-
-  /* Firstly, free mm_delaylist */
-
-  mm_free_delaylist(heap);
-
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
-   */
-
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
-  DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
-  DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  mm_takesemaphore(heap);
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
+  FAR void *ret = NULL;
 
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES - 1;
-    }
-  else
-    {
-      /* Convert the request size into a nodelist index */
-
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-    }
-
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
-   */
+  /* Find the best fitting free chunk that is large enough */
 
+  node = mm_findfreechunk(heap, alignsize);
   if (node)
     {
       FAR struct mm_freenode_s *remainder;
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -233,8 +169,128 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = (void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
 
-  DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
-  mm_givesemaphore(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_refill
+ *
+ * Description:
+ *  Allocate up to CONFIG_MM_SIZECLASS_BATCH more chunks of 'alignsize' bytes
+ *  into the size class cache of this CPU, so that the next allocations of
+ *  this size do not need the MM semaphore.
+ *
+ * Assumptions:
+ *  The caller holds the MM semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef MM_HAVE_SIZECLASS
+static void mm_sizeclass_refill(FAR struct mm_heap_s *heap,
+                                size_t alignsize)
+{
+  FAR void *mem;
+  int i;
+
+  for (i = 0; i < CONFIG_MM_SIZECLASS_BATCH; i++)
+    {
+      mem = mm_allocchunk(heap, alignsize);
+      if (mem == NULL)
+        {
+          break;
+        }
+
+      if (!mm_sizeclass_free(heap, mem))
+        {
+          /* The cache is full */
+
+          mm_freechunk(heap, mem);
+          break;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  size_t alignsize;
+  FAR void *ret;
+
+  /* Firstly, free mm_delaylist */
+
+  mm_free_delaylist(heap);
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+  DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
+  DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
+
+#ifdef MM_HAVE_SIZECLASS
+  /* Try the size class cache of this CPU first */
+
+  ret = mm_sizeclass_alloc(heap, alignsize);
+  if (ret == NULL)
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the
+       * nodelist.
+       */
+
+      mm_takesemaphore(heap);
+      ret = mm_allocchunk(heap, alignsize);
+
+#ifdef MM_HAVE_SIZECLASS
+      if (ret == NULL)
+        {
+          /* Return the cached chunks to the heap and try again */
+
+          if (mm_sizeclass_flush(heap))
+            {
+              ret = mm_allocchunk(heap, alignsize);
+            }
+        }
+      else if (alignsize <= MM_SIZECLASS_MAXCHUNK)
+        {
+          mm_sizeclass_refill(heap, alignsize);
+        }
+#endif
+
+      DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
+      mm_givesemaphore(heap);
+    }
+
+#ifdef MM_HAVE_PROFILE
+  if (ret)
+    {
+      mm_profile_alloc(heap, ret);
+    }
+#endif
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
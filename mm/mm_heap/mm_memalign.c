@@ -68,6 +68,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   size_t alignedchunk;
   size_t mask = (size_t)(alignment - 1);
   size_t allocsize;
+#ifdef MM_HAVE_PROFILE
+  struct mm_allocnode_s oldnode;
+#endif
 
   /* If this requested alinement's less than or equal to the natural alignment
    * of malloc, then just let malloc do the work.
@@ -113,6 +116,12 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   node = (FAR struct mm_allocnode_s *)(rawchunk - SIZEOF_MM_ALLOCNODE);
 
+#ifdef MM_HAVE_PROFILE
+  /* The tag is carried over to the aligned chunk */
+
+  oldnode = *node;
+#endif
+
   /* Find the aligned subregion */
 
   alignedchunk = (rawchunk + mask) & ~mask;
@@ -207,6 +216,10 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       mm_shrinkchunk(heap, node, size);
     }
 
+#ifdef MM_HAVE_PROFILE
+  mm_profile_move(heap, (FAR void *)alignedchunk, &oldnode);
+#endif
+
   mm_givesemaphore(heap);
   return (FAR void *)alignedchunk;
 }
@@ -0,0 +1,186 @@
+/****************************************************************************
+ * mm/mm_heap/mm_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef MM_HAVE_PROFILE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profile_alloc
+ *
+ * Description:
+ *   Tag a newly allocated chunk with the PID of the current task and add
+ *   it to the heap totals of that task.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   mem  - The user memory of the chunk
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_profile_alloc(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  node = (FAR struct mm_allocnode_s *)
+    ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+  /* The critical section keeps the totals consistent with concurrent frees
+   * by other tasks, other CPUs or interrupt handlers.
+   */
+
+  flags       = enter_critical_section();
+  node->seqno = ++heap->mm_seqno;
+  node->pid   = MM_PID_NONE;
+
+  tcb = nxsched_self();
+  if (tcb != NULL)
+    {
+      node->pid = (mmsize_t)tcb->pid;
+
+      tcb->heap_bytes += node->size;
+      if (tcb->heap_bytes > tcb->heap_peak)
+        {
+          tcb->heap_peak = tcb->heap_bytes;
+        }
+
+      tcb->heap_allocs++;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mm_profile_free
+ *
+ * Description:
+ *   Remove a chunk that is being freed from the heap totals of its owner.
+ *   The chunk is untagged so that it can be passed here only once.
+ *
+ *   If the owner has exited, the chunk is not accounted anywhere.  If its
+ *   PID has been reused meanwhile, the chunk is removed from the new task
+ *   instead, but the totals will never wrap below zero.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   mem  - The user memory of the chunk
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_profile_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  node = (FAR struct mm_allocnode_s *)
+    ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+  flags = enter_critical_section();
+  if (node->pid != MM_PID_NONE)
+    {
+      tcb = nxsched_get_tcb((pid_t)node->pid);
+      if (tcb != NULL)
+        {
+          tcb->heap_bytes = tcb->heap_bytes > node->size ?
+                            tcb->heap_bytes - node->size : 0;
+          tcb->heap_frees++;
+        }
+
+      node->pid = MM_PID_NONE;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mm_profile_move
+ *
+ * Description:
+ *   Carry the tag of a chunk over to its new node after memalign() or
+ *   realloc() has moved or resized it in place.  The owner keeps the chunk
+ *   and its heap total is adjusted by the change in size.  This is not an
+ *   allocation or a free, so those counts are not changed.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   mem  - The user memory of the chunk after the change
+ *   old  - A copy of the node header of the chunk before the change
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_profile_move(FAR struct mm_heap_s *heap, FAR void *mem,
+                     FAR const struct mm_allocnode_s *old)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  node = (FAR struct mm_allocnode_s *)
+    ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+  flags       = enter_critical_section();
+  node->pid   = old->pid;
+  node->seqno = old->seqno;
+
+  if (old->pid != MM_PID_NONE)
+    {
+      tcb = nxsched_get_tcb((pid_t)old->pid);
+      if (tcb != NULL)
+        {
+          tcb->heap_bytes = tcb->heap_bytes > old->size ?
+                            tcb->heap_bytes - old->size : 0;
+          tcb->heap_bytes += node->size;
+          if (tcb->heap_bytes > tcb->heap_peak)
+            {
+              tcb->heap_peak = tcb->heap_bytes;
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* MM_HAVE_PROFILE */
@@ -84,6 +84,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
   size_t prevsize = 0;
   size_t nextsize = 0;
   FAR void *newmem;
+#ifdef MM_HAVE_PROFILE
+  struct mm_allocnode_s oldtag;
+#endif
 
   /* If oldmem is NULL, then realloc is equivalent to malloc */
 
@@ -128,7 +131,13 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
       if (newsize < oldsize)
         {
+#ifdef MM_HAVE_PROFILE
+          oldtag = *oldnode;
+#endif
           mm_shrinkchunk(heap, oldnode, newsize);
+#ifdef MM_HAVE_PROFILE
+          mm_profile_move(heap, oldmem, &oldtag);
+#endif
         }
 
       /* Then return the original address */
@@ -164,6 +173,12 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
       size_t takeprev = 0;
       size_t takenext = 0;
 
+#ifdef MM_HAVE_PROFILE
+      /* The tag is carried over to the chunk with its new size */
+
+      oldtag = *oldnode;
+#endif
+
       /* Check if we can extend into the previous chunk and if the
        * previous chunk is smaller than the next chunk.
        */
@@ -225,16 +240,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           FAR struct mm_allocnode_s *newnode;
 
-          /* Remove the previous node.  There must be a predecessor, but
-           * there may not be a successor node.
-           */
+          /* Remove the previous node from the free list */
 
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          mm_delfreechunk(heap, prev);
 
           /* Extend the node into the previous free chunk */
 
@@ -299,16 +307,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
           andbeyond = (FAR struct mm_allocnode_s *)
                       ((FAR char *)next + nextsize);
 
-          /* Remove the next node.  There must be a predecessor, but there
-           * may not be a successor node.
-           */
+          /* Remove the next node from the free list */
 
-          DEBUGASSERT(next->blink);
-          next->blink->flink = next->flink;
-          if (next->flink)
-            {
-              next->flink->blink = next->blink;
-            }
+          mm_delfreechunk(heap, next);
 
           /* Extend the node into the next chunk */
 
@@ -343,6 +344,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
             }
         }
 
+#ifdef MM_HAVE_PROFILE
+      mm_profile_move(heap, newmem, &oldtag);
+#endif
+
       mm_givesemaphore(heap);
       return newmem;
     }
@@ -0,0 +1,325 @@
+/****************************************************************************
+ * mm/mm_heap/mm_sizeclass.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef MM_HAVE_SIZECLASS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Map a chunk size to its size class.  All chunk sizes are multiples of
+ * MM_MIN_CHUNK.
+ */
+
+#define MM_SIZECLASS_NDX(s)  (((s) >> MM_MIN_SHIFT) - 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_sizeclass_lock
+ *
+ * Description:
+ *   Disable local interrupts and return the size class caches of this CPU.
+ *   In the SMP case, the caches are also locked against a flush from
+ *   another CPU.
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_sizeclass_s *
+mm_sizeclass_lock(FAR struct mm_heap_s *heap, FAR irqstate_t *flags)
+{
+  FAR struct mm_sizeclass_s *sc;
+
+  *flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  sc = &heap->mm_sizeclass[up_cpu_index()];
+  spin_lock(&sc->sc_lock);
+#else
+  sc = &heap->mm_sizeclass[0];
+#endif
+
+  return sc;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_unlock
+ ****************************************************************************/
+
+static inline void mm_sizeclass_unlock(FAR struct mm_sizeclass_s *sc,
+                                       irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&sc->sc_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_sizeclass_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'size' bytes from the size class cache of this
+ *   CPU.  The heap semaphore is not needed.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   size - The aligned chunk size, including the allocated node header
+ *
+ * Returned Value:
+ *   The user memory of the chunk or NULL if the cache is empty or if the
+ *   size is too big to be cached.
+ *
+ ****************************************************************************/
+
+FAR void *mm_sizeclass_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_sizeclass_s *sc;
+  FAR struct mm_freenode_s *node;
+  irqstate_t flags;
+  int ndx;
+
+  if (size > MM_SIZECLASS_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx = MM_SIZECLASS_NDX(size);
+  sc  = mm_sizeclass_lock(heap, &flags);
+
+  node = sc->sc_head[ndx];
+  if (node != NULL)
+    {
+      sc->sc_head[ndx] = node->flink;
+      sc->sc_count[ndx]--;
+    }
+
+  mm_sizeclass_unlock(sc, flags);
+
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  DEBUGASSERT(node->size == size && (node->preceding & MM_ALLOC_BIT) != 0);
+  return (FAR char *)node + SIZEOF_MM_ALLOCNODE;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_free
+ *
+ * Description:
+ *   Release an allocated chunk into the size class cache of this CPU.  The
+ *   chunk remains marked as allocated in the heap.  This may be called from
+ *   an interrupt handler.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   mem  - The user memory of the chunk
+ *
+ * Returned Value:
+ *   true if the chunk was cached.  false if the chunk is too big or if the
+ *   cache of its size class is full.  In that case, the caller must return
+ *   the chunk to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_sizeclass_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_sizeclass_s *sc;
+  FAR struct mm_freenode_s *node;
+  irqstate_t flags;
+  bool cached = false;
+  int ndx;
+
+  node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  if (node->size > MM_SIZECLASS_MAXCHUNK)
+    {
+      return false;
+    }
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) != 0);
+
+  ndx = MM_SIZECLASS_NDX(node->size);
+  sc  = mm_sizeclass_lock(heap, &flags);
+
+  if (sc->sc_count[ndx] < CONFIG_MM_SIZECLASS_DEPTH)
+    {
+      node->flink      = sc->sc_head[ndx];
+      sc->sc_head[ndx] = node;
+      sc->sc_count[ndx]++;
+      cached           = true;
+    }
+
+  mm_sizeclass_unlock(sc, flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_flush
+ *
+ * Description:
+ *   Return the chunks in the size class caches of all CPUs to the heap.
+ *   This is done when an allocation cannot otherwise be satisfied.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *
+ * Returned Value:
+ *   true if any chunk was returned to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_sizeclass_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_sizeclass_s *sc;
+  FAR struct mm_freenode_s *list = NULL;
+  FAR struct mm_freenode_s *node;
+  FAR struct mm_freenode_s *tail;
+  irqstate_t flags;
+  int cpu;
+  int ndx;
+
+  /* Detach all of the cached chunks.  No CPU can hold its own cache lock
+   * for long, so this does not wait on the heap semaphore or any task.
+   */
+
+  for (cpu = 0; cpu < MM_SIZECLASS_NCPUS; cpu++)
+    {
+      sc    = &heap->mm_sizeclass[cpu];
+      flags = up_irq_save();
+#ifdef CONFIG_SMP
+      spin_lock(&sc->sc_lock);
+#endif
+
+      for (ndx = 0; ndx < MM_SIZECLASS_NCLASSES; ndx++)
+        {
+          node = sc->sc_head[ndx];
+          if (node != NULL)
+            {
+              for (tail = node; tail->flink != NULL; tail = tail->flink);
+
+              tail->flink       = list;
+              list              = node;
+              sc->sc_head[ndx]  = NULL;
+              sc->sc_count[ndx] = 0;
+            }
+        }
+
+#ifdef CONFIG_SMP
+      spin_unlock(&sc->sc_lock);
+#endif
+      up_irq_restore(flags);
+    }
+
+  if (list == NULL)
+    {
+      return false;
+    }
+
+  /* Then return them to the heap where they can be merged with their
+   * neighbors.
+   */
+
+  while (list != NULL)
+    {
+      node = list;
+      list = node->flink;
+      mm_freechunk(heap, (FAR char *)node + SIZEOF_MM_ALLOCNODE);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_info
+ *
+ * Description:
+ *   Return the number and the total size of the chunks that are held in the
+ *   size class caches.  These chunks are marked as allocated in the heap
+ *   but are available for allocation.
+ *
+ * Input Parameters:
+ *   heap   - The heap
+ *   cached - Location to return the total size of the cached chunks
+ *
+ * Returned Value:
+ *   The number of cached chunks.
+ *
+ ****************************************************************************/
+
+int mm_sizeclass_info(FAR struct mm_heap_s *heap, FAR size_t *cached)
+{
+  FAR struct mm_sizeclass_s *sc;
+  irqstate_t flags;
+  size_t size = 0;
+  int count = 0;
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < MM_SIZECLASS_NCPUS; cpu++)
+    {
+      sc    = &heap->mm_sizeclass[cpu];
+      flags = up_irq_save();
+#ifdef CONFIG_SMP
+      spin_lock(&sc->sc_lock);
+#endif
+
+      for (ndx = 0; ndx < MM_SIZECLASS_NCLASSES; ndx++)
+        {
+          count += sc->sc_count[ndx];
+          size  += (size_t)sc->sc_count[ndx] *
+                   ((size_t)(ndx + 1) << MM_MIN_SHIFT);
+        }
+
+#ifdef CONFIG_SMP
+      spin_unlock(&sc->sc_lock);
+#endif
+      up_irq_restore(flags);
+    }
+
+  *cached = size;
+  return count;
+}
+
+#endif /* MM_HAVE_SIZECLASS */
@@ -0,0 +1,225 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_TLSF_MANAGER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Chunks of this size or larger cannot be mapped to a free list.  The top
+ * bit of the chunk size is used as MM_ALLOC_BIT so no chunk is that large.
+ */
+
+#define MM_TLSF_MAXCHUNK ((size_t)1 << (8 * sizeof(mmsize_t) - 1))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_mapping
+ *
+ * Description:
+ *   Convert a chunk size to its first and second level free list indices.
+ *
+ ****************************************************************************/
+
+static inline void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  int msb;
+
+  DEBUGASSERT(size < MM_TLSF_MAXCHUNK);
+
+  if (size < ((size_t)1 << MM_TLSF_FLSHIFT))
+    {
+      /* Small chunks are spread linearly over the first level */
+
+      *fl = 0;
+      *sl = (int)(size >> MM_MIN_SHIFT);
+    }
+  else
+    {
+      /* msb is the zero-based index of the most significant bit.  The
+       * MM_TLSF_SLBITS bits below it select the second level list.
+       */
+
+      msb = fls((int)size) - 1;
+      *fl = msb - MM_TLSF_FLSHIFT + 1;
+      *sl = (int)(size >> (msb - MM_TLSF_SLBITS)) - MM_TLSF_SLCOUNT;
+    }
+
+  DEBUGASSERT(*fl < MM_TLSF_FLCOUNT && *sl < MM_TLSF_SLCOUNT);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of its TLSF free list.  It is assumed that
+ *   the caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *head;
+  int fl;
+  int sl;
+
+  DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) == 0);
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  head        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = head;
+
+  if (head)
+    {
+      head->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_flmap     |= (uint32_t)1 << fl;
+  heap->mm_slmap[fl] |= (uint32_t)1 << sl;
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its TLSF free list.  It is assumed that the
+ *   caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+      return;
+    }
+
+  /* The node is at the head of its list */
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+  DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+
+  heap->mm_freelist[fl][sl] = node->flink;
+  if (node->flink == NULL)
+    {
+      /* The list is now empty */
+
+      heap->mm_slmap[fl] &= ~((uint32_t)1 << sl);
+      if (heap->mm_slmap[fl] == 0)
+        {
+          heap->mm_flmap &= ~((uint32_t)1 << fl);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes in constant time.  The size
+ *   is first rounded up to the next second level boundary so that any
+ *   chunk in the selected list is large enough.  The chunk is not removed
+ *   from its free list.  It is assumed that the caller holds the mm
+ *   semaphore
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  size_t rounded = size;
+  uint32_t flmap;
+  uint32_t slmap;
+  int fl;
+  int sl;
+
+  if (size >= ((size_t)1 << MM_TLSF_FLSHIFT) && size < MM_TLSF_MAXCHUNK)
+    {
+      rounded += ((size_t)1 << (fls((int)size) - 1 - MM_TLSF_SLBITS)) - 1;
+    }
+
+  if (rounded >= MM_TLSF_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  mm_tlsf_mapping(rounded, &fl, &sl);
+
+  /* Search the lists of this first level index for a list at least as
+   * large as the rounded size.  If there is none, take the smallest list
+   * of the next non-empty first level index.
+   */
+
+  slmap = heap->mm_slmap[fl] & ((uint32_t)-1 << sl);
+  if (slmap == 0)
+    {
+      flmap = heap->mm_flmap & ((uint32_t)-1 << (fl + 1));
+      if (flmap == 0)
+        {
+          return NULL;
+        }
+
+      fl    = ffs((int)flmap) - 1;
+      slmap = heap->mm_slmap[fl];
+    }
+
+  sl = ffs((int)slmap) - 1;
+
+  DEBUGASSERT(heap->mm_freelist[fl][sl] != NULL &&
+              heap->mm_freelist[fl][sl]->size >= size);
+  return heap->mm_freelist[fl][sl];
+}
+
+#endif /* CONFIG_MM_TLSF_MANAGER */
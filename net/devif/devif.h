@@ -51,6 +51,7 @@
 #include <errno.h>
 #include <arch/irq.h>
 
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
 
 /****************************************************************************
@@ -481,6 +482,41 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
                     unsigned int len, unsigned int offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_iob_recv
+ *
+ * Description:
+ *   Take the I/O buffer that holds the incoming packet from the driver so
+ *   that received data can be queued without copying it.  The driver gets
+ *   a new I/O buffer in its place with a copy of the packet headers, so a
+ *   response can still be built in d_buf.
+ *
+ * Input Parameters:
+ *   dev        - The network device that received the packet
+ *   buffer     - The start of the data to keep.  Must lie in d_buf.
+ *   buflen     - The length of the data to keep
+ *   headroom   - The number of bytes that the caller needs in front of the
+ *                data.  These bytes are included in the I/O buffer.
+ *   consumerid - The user of the new I/O buffer
+ *
+ * Returned Value:
+ *   The I/O buffer that holds 'headroom' bytes followed by the data.  NULL
+ *   is returned if the driver did not provide an I/O buffer, if there is
+ *   not enough headroom or if no replacement is available.  The caller
+ *   must then copy the data.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+FAR struct iob_s *devif_iob_recv(FAR struct net_driver_s *dev,
+                                 FAR uint8_t *buffer, unsigned int buflen,
+                                 unsigned int headroom,
+                                 enum iob_user_e consumerid);
+#endif
+
 /****************************************************************************
  * Name: devif_pkt_send
  *
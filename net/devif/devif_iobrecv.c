@@ -0,0 +1,144 @@
+/****************************************************************************
+ * net/devif/devif_iobrecv.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "devif/devif.h"
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_iob_recv
+ *
+ * Description:
+ *   Take the I/O buffer that holds the incoming packet from the driver so
+ *   that received data can be queued without copying it.  The driver gets
+ *   a new I/O buffer in its place with a copy of the packet headers, so a
+ *   response can still be built in d_buf.
+ *
+ * Input Parameters:
+ *   dev        - The network device that received the packet
+ *   buffer     - The start of the data to keep.  Must lie in d_buf.
+ *   buflen     - The length of the data to keep
+ *   headroom   - The number of bytes that the caller needs in front of the
+ *                data.  These bytes are included in the I/O buffer.
+ *   consumerid - The user that takes over the returned I/O buffer
+ *
+ * Returned Value:
+ *   The I/O buffer that holds 'headroom' bytes followed by the data.  NULL
+ *   is returned if the driver did not provide an I/O buffer, if there is
+ *   not enough headroom or if no replacement is available.  The caller
+ *   must then copy the data.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *devif_iob_recv(FAR struct net_driver_s *dev,
+                                 FAR uint8_t *buffer, unsigned int buflen,
+                                 unsigned int headroom,
+                                 enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *newiob;
+  unsigned int bufoff;
+  unsigned int dataoff;
+
+  /* The data must lie in the I/O buffer of the driver, after d_buf */
+
+  if (iob == NULL || dev->d_buf < iob->io_data || buffer < dev->d_buf ||
+      buffer + buflen > iob->io_data + IOB_BUFSIZE(iob))
+    {
+      return NULL;
+    }
+
+  bufoff  = dev->d_buf - iob->io_data;
+  dataoff = buffer - iob->io_data;
+
+  if (dataoff < headroom)
+    {
+      return NULL;
+    }
+
+  /* Get a replacement of the same size without waiting.  It belongs to
+   * the driver, like the I/O buffer that it replaces.
+   */
+
+  newiob = iob_tryalloc_len(IOB_BUFSIZE(iob), true, IOBUSER_NET_NETDEV);
+  if (newiob == NULL)
+    {
+      return NULL;
+    }
+
+  if (IOB_BUFSIZE(newiob) < IOB_BUFSIZE(iob))
+    {
+      iob_free(newiob, IOBUSER_NET_NETDEV);
+      return NULL;
+    }
+
+  /* Copy the headers that precede the data.  The response to this packet
+   * is built in place of these.
+   */
+
+  memcpy(&newiob->io_data[bufoff], dev->d_buf, dataoff - bufoff);
+
+  dev->d_appdata = &newiob->io_data[dev->d_appdata - iob->io_data];
+#ifdef CONFIG_NET_TCPURGDATA
+  if (dev->d_urgdata != NULL)
+    {
+      dev->d_urgdata = &newiob->io_data[dev->d_urgdata - iob->io_data];
+    }
+#endif
+
+  dev->d_buf = &newiob->io_data[bufoff];
+  dev->d_iob = newiob;
+
+  /* The old I/O buffer now belongs to the caller and holds only the
+   * headroom and the data.  The caller frees it under its own user ID.
+   */
+
+  iob_stats_handover(IOBUSER_NET_NETDEV, consumerid);
+
+  iob->io_flink  = NULL;
+  iob->io_offset = dataoff - headroom;
+  iob->io_len    = buflen + headroom;
+  iob->io_pktlen = buflen + headroom;
+
+  ninfo("Took %u bytes in iob=%p\n", buflen, iob);
+  return iob;
+}
+
+#endif /* CONFIG_NET_RECV_ZEROCOPY */
@@ -564,23 +564,49 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
                                              devif_poll_callback_t callback)
 {
   FAR struct tcp_conn_s *conn  = NULL;
+  bool sent;
+  int nsegs;
   int bstop = 0;
 
   /* Traverse all of the active TCP connections and perform the poll action */
 
   while (!bstop && (conn = tcp_nextconn(conn)))
     {
-      /* Perform the TCP TX poll */
+      /* Poll the connection again while it sends segments and the driver
+       * can accept more packets, up to CONFIG_NET_TCP_TXBATCH segments.
+       */
 
-      tcp_poll(dev, conn);
+      nsegs = 0;
+      do
+        {
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+          /* The poll may have been requested by the retransmission timer
+           * of the connection.  If the timer has expired, then retransmit
+           * now rather than waiting for the next timer poll.
+           */
 
-      /* Perform any necessary conversions on outgoing packets */
+          if (tcp_rtx_expired(conn))
+            {
+              tcp_timer(dev, conn, 0);
+            }
+          else
+#endif
+            {
+              /* Perform the TCP TX poll */
 
-      devif_packet_conversion(dev, DEVIF_TCP);
+              tcp_poll(dev, conn);
+            }
 
-      /* Call back into the driver */
+          /* Perform any necessary conversions on outgoing packets */
 
-      bstop = callback(dev);
+          devif_packet_conversion(dev, DEVIF_TCP);
+
+          /* Call back into the driver */
+
+          sent  = (dev->d_len > 0);
+          bstop = callback(dev);
+        }
+      while (!bstop && sent && ++nsegs < CONFIG_NET_TCP_TXBATCH);
     }
 
   return bstop;
@@ -656,6 +682,9 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
  *   is set to a value larger than zero. The device driver should then send
  *   out the packet.
  *
+ *   A TCP connection that sends a segment is polled again, up to
+ *   CONFIG_NET_TCP_TXBATCH times, while the callback returns zero.
+ *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
  *   locked.
@@ -53,6 +53,32 @@
 
 #ifdef HAVE_LOCAL_POLL
 
+/****************************************************************************
+ * Name: local_inout_poll_cb
+ *
+ * Description:
+ *   Called by poll_notify() when one of the shadow pollfds of a POLLIN |
+ *   POLLOUT poll is notified.  The events are passed on to the pollfd of
+ *   the caller at once so that a persistent poll (epoll) sees them without
+ *   waiting for the teardown.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_inout_poll_cb(FAR struct pollfd *shadowfds)
+{
+  FAR struct pollfd *fds = (FAR struct pollfd *)shadowfds->ptr;
+
+  fds->revents      |= shadowfds->revents;
+  shadowfds->revents = 0;
+
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: local_accept_pollsetup
  ****************************************************************************/
@@ -152,7 +178,7 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -232,10 +258,14 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
           shadowfds[0].fd     = 1; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
+          shadowfds[0].ptr    = fds;
+          shadowfds[0].cb     = local_inout_poll_cb;
           shadowfds[0].events = fds->events & ~POLLOUT;
 
           shadowfds[1].fd     = 0; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
+          shadowfds[1].ptr    = fds;
+          shadowfds[1].cb     = local_inout_poll_cb;
           shadowfds[1].events = fds->events & ~POLLIN;
 
           net_unlock();
@@ -304,7 +334,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(fds);
   return OK;
 #endif
 }
@@ -45,6 +45,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/net/ip.h>
 
 #ifdef CONFIG_NETDOWN_NOTIFIER
@@ -75,7 +76,9 @@ extern "C"
 #endif
 
 /* List of registered Ethernet device drivers.  You must have the network
- * locked in order to access this list.
+ * locked in order to access this list.  Modifications of the list are also
+ * done under netdev_list_lock(), so lookups that do not otherwise need the
+ * network lock may walk the list under netdev_list_lock() instead.
  *
  * NOTE that this duplicates a declaration in net/tcp/tcp.h
  */
@@ -125,6 +128,21 @@ typedef int (*netdev_callback_t)(FAR struct net_driver_s *dev, FAR void *arg);
 void netdev_ifup(FAR struct net_driver_s *dev);
 void netdev_ifdown(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_list_lock / netdev_list_unlock
+ *
+ * Description:
+ *   Lock and unlock the list of registered devices (g_netdevices and
+ *   g_devset) without taking the network lock.  This is a spinlock that
+ *   also disables local interrupts.  It may be taken with or without the
+ *   network lock, but the network lock must never be taken while holding
+ *   it.  Nothing that may block may be done while holding it.
+ *
+ ****************************************************************************/
+
+irqstate_t netdev_list_lock(void);
+void netdev_list_unlock(irqstate_t flags);
+
 /****************************************************************************
  * Name: netdev_verify
  *
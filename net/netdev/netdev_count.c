@@ -68,10 +68,11 @@
 int netdev_count(void)
 {
   struct net_driver_s *dev;
+  irqstate_t flags;
   int ndev;
 
-  net_lock();
+  flags = netdev_list_lock();
   for (dev = g_netdevices, ndev = 0; dev; dev = dev->flink, ndev++);
-  net_unlock();
+  netdev_list_unlock(flags);
   return ndev;
 }
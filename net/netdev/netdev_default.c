@@ -73,10 +73,11 @@ FAR struct net_driver_s *netdev_default(void)
 {
   FAR struct net_driver_s *ret = NULL;
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
 
   /* Examine each registered network device */
 
-  net_lock();
+  flags = netdev_list_lock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "up" state? */
@@ -96,6 +97,6 @@ FAR struct net_driver_s *netdev_default(void)
         }
     }
 
-  net_unlock();
+  netdev_list_unlock(flags);
   return ret;
 }
@@ -81,10 +81,11 @@
 FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
 {
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
 
   /* Examine each registered network device */
 
-  net_lock();
+  flags = netdev_list_lock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "up" state? */
@@ -98,7 +99,7 @@ FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
             {
               /* Its a match */
 
-              net_unlock();
+              netdev_list_unlock(flags);
               return dev;
             }
         }
@@ -106,7 +107,7 @@ FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
 
   /* No device with the matching address found */
 
-  net_unlock();
+  netdev_list_unlock(flags);
   return NULL;
 }
 #endif /* CONFIG_NET_IPv4 */
@@ -132,10 +133,11 @@ FAR struct net_driver_s *netdev_findby_lipv4addr(in_addr_t lipaddr)
 FAR struct net_driver_s *netdev_findby_lipv6addr(const net_ipv6addr_t lipaddr)
 {
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
 
   /* Examine each registered network device */
 
-  net_lock();
+  flags = netdev_list_lock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "up" state? */
@@ -149,7 +151,7 @@ FAR struct net_driver_s *netdev_findby_lipv6addr(const net_ipv6addr_t lipaddr)
             {
               /* Its a match */
 
-              net_unlock();
+              netdev_list_unlock(flags);
               return dev;
             }
         }
@@ -157,7 +159,7 @@ FAR struct net_driver_s *netdev_findby_lipv6addr(const net_ipv6addr_t lipaddr)
 
   /* No device with the matching address found */
 
-  net_unlock();
+  netdev_list_unlock(flags);
   return NULL;
 }
 #endif /* CONFIG_NET_IPv6 */
@@ -71,6 +71,7 @@
 FAR struct net_driver_s *netdev_findbyindex(int ifindex)
 {
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
   int i;
 
 #ifdef CONFIG_NETDEV_IFINDEX
@@ -85,7 +86,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     }
 #endif
 
-  net_lock();
+  flags = netdev_list_lock();
 
 #ifdef CONFIG_NETDEV_IFINDEX
   /* Check if this index has been assigned */
@@ -94,7 +95,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     {
       /* This index has not been assigned */
 
-      net_unlock();
+      netdev_list_unlock(flags);
       return NULL;
     }
 #endif
@@ -117,12 +118,12 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
       if (i == (ifindex - 1))
 #endif
         {
-          net_unlock();
+          netdev_list_unlock(flags);
           return dev;
         }
     }
 
-  net_unlock();
+  netdev_list_unlock(flags);
   return NULL;
 }
 
@@ -154,7 +155,8 @@ int netdev_nextindex(int ifindex)
 
   if (ifindex >= 0 && ifindex < MAX_IFINDEX)
     {
-      net_lock();
+      irqstate_t flags = netdev_list_lock();
+
       for (; ifindex < MAX_IFINDEX; ifindex++)
         {
           if ((g_devset & (1L << ifindex)) != 0)
@@ -163,12 +165,12 @@ int netdev_nextindex(int ifindex)
                * mean no-index in the POSIX standards.
                */
 
-              net_unlock();
+              netdev_list_unlock(flags);
               return ifindex + 1;
             }
         }
 
-      net_unlock();
+      netdev_list_unlock(flags);
     }
 
   return -ENODEV;
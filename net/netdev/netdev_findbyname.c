@@ -69,20 +69,21 @@
 FAR struct net_driver_s *netdev_findbyname(FAR const char *ifname)
 {
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
 
   if (ifname)
     {
-      net_lock();
+      flags = netdev_list_lock();
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (strcmp(ifname, dev->d_ifname) == 0)
             {
-              net_unlock();
+              netdev_list_unlock(flags);
               return dev;
             }
         }
 
-      net_unlock();
+      netdev_list_unlock(flags);
     }
 
   return NULL;
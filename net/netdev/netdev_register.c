@@ -33,6 +33,8 @@
 
 #include <net/if.h>
 #include <net/ethernet.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ethernet.h>
@@ -102,6 +104,16 @@ uint32_t g_devset;
 uint32_t g_devfreed;
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+/* Protects the list of registered devices for netdev_list_lock() */
+
+static spinlock_t g_netdev_lock;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -212,6 +224,46 @@ static int get_ifindex(void)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: netdev_list_lock
+ *
+ * Description:
+ *   Lock the list of registered devices without taking the network lock.
+ *
+ * Returned Value:
+ *   The interrupt state to be passed to netdev_list_unlock().
+ *
+ ****************************************************************************/
+
+irqstate_t netdev_list_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  spin_lock(&g_netdev_lock);
+#endif
+  return flags;
+}
+
+/****************************************************************************
+ * Name: netdev_list_unlock
+ *
+ * Description:
+ *   Unlock the list of registered devices.
+ *
+ * Input Parameters:
+ *   flags - The value returned by netdev_list_lock()
+ *
+ ****************************************************************************/
+
+void netdev_list_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&g_netdev_lock);
+#endif
+  up_irq_restore(flags);
+}
+
 /****************************************************************************
  * Name: netdev_register
  *
@@ -244,6 +296,7 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
   FAR const char *devfmt;
   uint16_t pktsize = 0;
   uint8_t llhdrlen = 0;
+  irqstate_t flags;
   int devnum;
 #ifdef CONFIG_NETDEV_IFINDEX
   int ifindex;
@@ -370,9 +423,13 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       net_lock();
 
 #ifdef CONFIG_NETDEV_IFINDEX
+      flags   = netdev_list_lock();
       ifindex = get_ifindex();
+      netdev_list_unlock(flags);
+
       if (ifindex < 0)
         {
+          net_unlock();
           return ifindex;
         }
 
@@ -428,8 +485,10 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 
       /* Add the device to the list of known network devices */
 
-      dev->flink  = g_netdevices;
+      flags        = netdev_list_lock();
+      dev->flink   = g_netdevices;
       g_netdevices = dev;
+      netdev_list_unlock(flags);
 
 #ifdef CONFIG_NET_IGMP
       /* Configure the device for IGMP support */
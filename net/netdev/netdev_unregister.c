@@ -127,10 +127,12 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 {
   struct net_driver_s *prev;
   struct net_driver_s *curr;
+  irqstate_t flags;
 
   if (dev)
     {
       net_lock();
+      flags = netdev_list_lock();
 
       /* Find the device in the list of known network devices */
 
@@ -163,6 +165,7 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
+      netdev_list_unlock(flags);
       net_unlock();
 
 #ifdef CONFIG_NET_ETHERNET
@@ -64,11 +64,12 @@
 bool netdev_verify(FAR struct net_driver_s *dev)
 {
   FAR struct net_driver_s *chkdev;
+  irqstate_t flags;
   bool valid = false;
 
   /* Search the list of registered devices */
 
-  net_lock();
+  flags = netdev_list_lock();
   for (chkdev = g_netdevices; chkdev != NULL; chkdev = chkdev->flink)
     {
       /* Is the network device that we are looking for? */
@@ -82,6 +83,6 @@ bool netdev_verify(FAR struct net_driver_s *dev)
         }
     }
 
-  net_unlock();
+  netdev_list_unlock(flags);
   return valid;
 }
@@ -52,6 +52,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 
 #include "netlink/netlink.h"
@@ -543,12 +544,12 @@ static void netlink_response_available(FAR void *arg)
   sched_lock();
   net_lock();
 
-  if (conn->pollsem != NULL && conn->pollevent != NULL)
+  if (conn->fds != NULL)
     {
       /* Wake up the poll() with POLLIN */
 
-       *conn->pollevent |= POLLIN;
-       nxsem_post(conn->pollsem);
+      conn->fds->revents |= POLLIN;
+      poll_notify(conn->fds);
     }
   else
     {
@@ -557,8 +558,7 @@ static void netlink_response_available(FAR void *arg)
 
   /* Allow another poll() */
 
-  conn->pollsem   = NULL;
-  conn->pollevent = NULL;
+  conn->fds = NULL;
 
   net_unlock();
   sched_unlock();
@@ -622,7 +622,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
       if (revents != 0)
         {
           fds->revents = revents;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
           net_unlock();
           return OK;
         }
@@ -637,7 +637,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
            * on the Netlink connection.
            */
 
-          if (conn->pollsem != NULL || conn->pollevent != NULL)
+          if (conn->fds != NULL)
             {
               nerr("ERROR: Multiple polls() on socket not supported.\n");
               net_unlock();
@@ -646,16 +646,14 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
 
           /* Set up the notification */
 
-          conn->pollsem    = fds->sem;
-          conn->pollevent  = &fds->revents;
+          conn->fds = fds;
 
           ret = netlink_notifier_setup(netlink_response_available,
                                        conn, conn);
           if (ret < 0)
             {
               nerr("ERROR: netlink_notifier_setup() failed: %d\n", ret);
-              conn->pollsem   = NULL;
-              conn->pollevent = NULL;
+              conn->fds = NULL;
             }
         }
 
@@ -666,8 +664,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
       /* Cancel any response notifications */
 
       ret = netlink_notifier_teardown(conn);
-      conn->pollsem   = NULL;
-      conn->pollevent = NULL;
+      conn->fds = NULL;
     }
 
   return ret;
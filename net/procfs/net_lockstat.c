@@ -0,0 +1,170 @@
+/****************************************************************************
+ * net/procfs/net_lockstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* The output of /proc/net/lock looks like:
+ *
+ *   SITE                ACQUIRED  CONTENDED    MAX(us)   TOTAL(ms)
+ *   0x0801a2c5              1234         12         87          45
+ *   ...
+ *   other                     12          0          3           0
+ *
+ * SITE is the return address of the net_lock() call.  It can be resolved
+ * to a function with addr2line.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "utils/utils.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_LOCK_STATS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One header line and one line for each call site, including the entry of
+ * the call sites that did not fit in the table.
+ */
+
+#define NLOCKSTAT_LINES (CONFIG_NET_LOCK_STATS_NSITES + 2)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static int netprocfs_lockstat_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_lockstat_site(FAR struct netprocfs_file_s *netfile);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions.  All lines but the first are generated by the
+ * same function, so the table is filled in when it is first used.
+ */
+
+static linegen_t g_lockstat_linegen[NLOCKSTAT_LINES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_lockstat_header
+ ****************************************************************************/
+
+static int netprocfs_lockstat_header(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN, "%-18s%11s%11s%11s%12s\n",
+                  "SITE", "ACQUIRED", "CONTENDED", "MAX(us)", "TOTAL(ms)");
+}
+
+/****************************************************************************
+ * Name: netprocfs_lockstat_site
+ ****************************************************************************/
+
+static int netprocfs_lockstat_site(FAR struct netprocfs_file_s *netfile)
+{
+  struct net_lockstat_s stat;
+  int index = netfile->lineno - 1;
+  int len;
+
+  /* Call sites that are not in use generate no output */
+
+  if (net_lockstat(index, &stat) < 0)
+    {
+      return 0;
+    }
+
+  if (index < CONFIG_NET_LOCK_STATS_NSITES)
+    {
+      len = snprintf(netfile->line, NET_LINELEN, "%-18p", stat.site);
+    }
+  else
+    {
+      len = snprintf(netfile->line, NET_LINELEN, "%-18s", "other");
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len,
+                  "%11lu%11lu%11lu%12lu\n",
+                  (unsigned long)stat.acquired,
+                  (unsigned long)stat.contended,
+                  (unsigned long)stat.maxheld,
+                  (unsigned long)(stat.held / USEC_PER_MSEC));
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format network lock statistics.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen)
+{
+  int i;
+
+  if (g_lockstat_linegen[0] == NULL)
+    {
+      for (i = 1; i < NLOCKSTAT_LINES; i++)
+        {
+          g_lockstat_linegen[i] = netprocfs_lockstat_site;
+        }
+
+      g_lockstat_linegen[0] = netprocfs_lockstat_header;
+    }
+
+  return netprocfs_read_linegen(priv, buffer, buflen, g_lockstat_linegen,
+                                NLOCKSTAT_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_LOCK_STATS */
@@ -74,12 +74,19 @@
 #  define STAT_INDEX     0
 #  ifdef CONFIG_NET_MLD
 #    define MLD_INDEX    1
-#    define _ROUTE_INDEX 2
+#    define _LOCK_INDEX  2
 #  else
-#    define _ROUTE_INDEX 1
+#    define _LOCK_INDEX  1
 #  endif
 #else
-#  define _ROUTE_INDEX   0
+#  define _LOCK_INDEX    0
+#endif
+
+#ifdef CONFIG_NET_LOCK_STATS
+#  define LOCK_INDEX     _LOCK_INDEX
+#  define _ROUTE_INDEX   (_LOCK_INDEX + 1)
+#else
+#  define _ROUTE_INDEX   _LOCK_INDEX
 #endif
 
 #ifdef CONFIG_NET_ROUTE
@@ -195,6 +202,19 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
 #endif
 #endif
 
+#ifdef CONFIG_NET_LOCK_STATS
+  /* "net/lock" is an acceptable value for the relpath only if network lock
+   * statistics are enabled.
+   */
+
+  if (strcmp(relpath, "net/lock") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_LOCK;
+      dev   = NULL;
+    }
+  else
+#endif
+
 #ifdef CONFIG_NET_ROUTE
   /* "net/route" is an acceptable value for the relpath only if routing
    * table support is initialized.
@@ -325,6 +345,15 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
 #endif
 #endif
 
+#ifdef CONFIG_NET_LOCK_STATS
+      case NETPROCFS_SUBDIR_LOCK:
+
+        /* Show the network lock statistics */
+
+        nreturned = netprocfs_read_lockstats(priv, buffer, buflen);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -446,6 +475,9 @@ static int netprocfs_opendir(FAR const char *relpath,
       level1->base.nentries++;
 #endif
 #endif
+#ifdef CONFIG_NET_LOCK_STATS
+      level1->base.nentries++;
+#endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
 #endif
@@ -552,6 +584,16 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
       else
 #endif
 #endif
+#ifdef CONFIG_NET_LOCK_STATS
+      if (index == LOCK_INDEX)
+        {
+          /* Copy the network lock statistics directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "lock", NAME_MAX + 1);
+        }
+      else
+#endif
 #ifdef CONFIG_NET_ROUTE
       if (index == ROUTE_INDEX)
         {
@@ -683,6 +725,15 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
   else
 #endif
 #endif
+#ifdef CONFIG_NET_LOCK_STATS
+  /* Check for network lock statistics "net/lock" */
+
+  if (strcmp(relpath, "net/lock") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
 #ifdef CONFIG_NET_ROUTE
   /* Check for network statistics "net/stat" */
 
@@ -32,6 +32,7 @@
 #include <debug.h>
 #include <assert.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
@@ -70,6 +71,15 @@ int psock_close(FAR struct socket *psock)
       return -EBADF;
     }
 
+  /* Drop the epoll registrations of the socket when the last reference
+   * goes away.
+   */
+
+  if (psock->s_crefs <= 1)
+    {
+      epoll_release(psock);
+    }
+
   /* We perform the close operation only if this is the last count on
    * the socket. (actually, I think the socket crefs only takes the values
    * 0 and 1 right now).
@@ -0,0 +1,210 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <stdbool.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET_CMSG
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket.  This is
+ *   an internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   The network is locked only once for the whole batch.  The lock is
+ *   still given up while waiting for data.  Local sockets wait on their
+ *   FIFOs with the network unlocked, so the network is not locked for them.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of messages to receive
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags
+ *   timeout - Time limit on the whole operation (may be NULL).  As with
+ *             Linux, the timeout is checked only after each message has
+ *             been received.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  The msg_len
+ *   field of each message holds the number of bytes received.  If no
+ *   message could be received, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t deadline = 0;
+  unsigned int count;
+  bool locked;
+  ssize_t ret = OK;
+
+  /* Verify that non-NULL pointers were passed */
+
+  if (msgvec == NULL || vlen == 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      deadline = clock_systime_ticks() + SEC2TICK(timeout->tv_sec) +
+                 NSEC2TICK(timeout->tv_nsec);
+    }
+
+  locked = (psock->s_domain != PF_LOCAL);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (count = 0; count < vlen; count++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[count].msg_hdr,
+                          flags & ~MSG_WAITFORONE);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+
+      /* Do not wait for more messages once the first one has been received
+       * if so requested.
+       */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL &&
+          (sclock_t)(clock_systime_ticks() - deadline) >= 0)
+        {
+          count++;
+          break;
+        }
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Errors after the first message are not reported.  The next call will
+   * return the error if it persists.
+   */
+
+  return count > 0 ? (int)count : (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   The recvmmsg() call receives multiple messages from a socket with a
+ *   single call.  It is an extension of recvmsg() that reduces the
+ *   per-message overhead of datagram sockets.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   The array of messages to receive
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags.  In addition to the recvmsg() flags,
+ *            MSG_WAITFORONE turns on MSG_DONTWAIT after the first message
+ *            has been received.
+ *   timeout  Time limit on the whole operation (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set as for recvmsg().  An error is reported only
+ *   if no message could be received.
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET_CMSG */
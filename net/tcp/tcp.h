@@ -49,10 +49,14 @@
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
 
-#ifdef CONFIG_NET_TCP_NOTIFIER
+#if defined(CONFIG_NET_TCP_NOTIFIER) || defined(CONFIG_NET_TCP_HIRES_RTO)
 #  include <nuttx/wqueue.h>
 #endif
 
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+#  include <nuttx/wdog.h>
+#endif
+
 #if defined(CONFIG_NET_TCP) && !defined(CONFIG_NET_TCP_NO_STACK)
 
 /****************************************************************************
@@ -100,6 +104,27 @@
 #  endif
 #endif
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+#  if (CONFIG_NET_TCP_CONNHASH_SIZE & (CONFIG_NET_TCP_CONNHASH_SIZE - 1)) != 0
+#    error CONFIG_NET_TCP_CONNHASH_SIZE must be a power of two
+#  endif
+
+/* TCP connection hash table access macros.  TCP_PORTHASH() returns the
+ * bucket of a local port, in either byte order.
+ */
+
+#  define TCP_HASH_MASK              (CONFIG_NET_TCP_CONNHASH_SIZE - 1)
+#  define TCP_PORTHASH(p)            (((p) ^ ((p) >> 8)) & TCP_HASH_MASK)
+#endif
+
+/* The congestion avoidance algorithm of new connections */
+
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+#  define TCP_CC_DEFAULT             (&g_tcp_cubic)
+#elif defined(CONFIG_NET_TCP_CC)
+#  define TCP_CC_DEFAULT             (&g_tcp_newreno)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -122,6 +147,7 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_cc_ops_s;      /* Forward reference */
 
 /* This is a container that holds the poll-related information */
 
@@ -174,11 +200,26 @@ struct tcp_conn_s
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
   uint8_t  domain;        /* IP domain: PF_INET or PF_INET6 */
 #endif
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+  uint32_t srtt;          /* Smoothed round-trip time (units: msec / 8) */
+  uint32_t rttvar;        /* Round-trip time variation (units: msec / 4) */
+  uint32_t rto;           /* Retransmission time-out (units: msec) */
+  uint32_t rtt_seq;       /* Sequence number that ends the timed segment */
+  uint32_t rtt_sndnxt;    /* Sequence number of the next new segment */
+  clock_t  rtt_time;      /* Time when the timed segment was sent */
+  bool     rtt_timing;    /* True: A segment is being timed */
+  clock_t  rtx_time;      /* Time when the retransmission timer started */
+  clock_t  rtx_ticks;     /* Duration of the retransmission timer */
+  bool     rtx_armed;     /* True: The retransmission timer is running */
+  struct wdog_s rtx_wdog; /* Expires the retransmission timer */
+  struct work_s rtx_work; /* Polls the device when the timer expires */
+#else
   uint8_t  sa;            /* Retransmission time-out calculation state
                            * variable */
   uint8_t  sv;            /* Retransmission time-out calculation state
                            * variable */
   uint8_t  rto;           /* Retransmission time-out */
+#endif
   uint8_t  tcpstateflags; /* TCP state and flags */
   uint8_t  timer;         /* The retransmission timer (units: half-seconds) */
   uint8_t  nrtx;          /* The number of retransmissions for the last
@@ -191,13 +232,47 @@ struct tcp_conn_s
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current window size of the connection */
+  uint8_t  snd_scale;     /* Shift count of the windows received from the
+                           * peer (RFC 7323) */
+  uint8_t  rcv_scale;     /* Shift count of the windows advertised to the
+                           * peer.  Zero if not negotiated */
+  bool     wscale;        /* True: The peer sent the window scale option */
+#else
   uint16_t winsize;       /* Current window size of the connection */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  bool     sack;          /* True: The peer sent the SACK-permitted option */
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #else
   uint16_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control (RFC 5681).  'cc' is the congestion avoidance
+   * algorithm of the connection.
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t cwnd;          /* Congestion window.  Zero until the first data
+                           * is sent */
+  uint32_t ssthresh;      /* Slow start threshold */
+  uint32_t lastack;       /* The last acknowledgement number received */
+  uint32_t recover;       /* The highest sequence number sent when fast
+                           * recovery was entered (RFC 6582) */
+  uint8_t  dupacks;       /* Number of duplicate ACKs received */
+  bool     recovery;      /* True: In fast recovery */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  uint32_t cubic_wmax;    /* Window before the last reduction (bytes) */
+  uint32_t cubic_west;    /* Window estimate of standard TCP (bytes) */
+  uint32_t cubic_k;       /* Time to grow back to cubic_wmax (msec) */
+  clock_t  cubic_epoch;   /* Start of the current avoidance period */
+#endif
+#endif
+
   /* If the TCP socket is bound to a local address, then this is
    * a reference to the device that routes traffic on the corresponding
    * network.
@@ -247,6 +322,23 @@ struct tcp_conn_s
   FAR struct tcp_backlog_s *backlog;
 #endif
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Connection lookup hash chains
+   *
+   *   hnext - The next active connection in the same bucket of the
+   *     connection hash table.  That table is indexed by the remote
+   *     address and the local and remote ports.
+   *   pnext - The next connection in the same bucket of the local port hash
+   *     table.  That table holds all connections with a local port.
+   *   lnext - The next connection in the same bucket of the listener hash
+   *     table.
+   */
+
+  FAR struct tcp_conn_s    *hnext;
+  FAR struct tcp_conn_s    *pnext;
+  FAR struct tcp_conn_s    *lnext;
+#endif
+
 #ifdef CONFIG_NET_TCP_KEEPALIVE
   /* There fields manage TCP/IP keep-alive.  All times are in units of the
    * system clock tick.
@@ -299,10 +391,38 @@ struct tcp_wrbuffer_s
   uint16_t   wb_sent;      /* Number of bytes sent from the I/O buffer chain */
   uint8_t    wb_nrtx;      /* The number of retransmissions for the last
                             * segment sent */
+#ifdef CONFIG_NET_TCP_SACK
+  bool       wb_sacked;    /* All of the data was selectively ACKed */
+#endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* A congestion avoidance algorithm.  Slow start, fast retransmit and
+ * fast recovery are common to all of the algorithms.
+ */
+
+struct tcp_cc_ops_s
+{
+  /* The name used with the TCP_CONGESTION socket option */
+
+  FAR const char *name;
+
+  /* Reset the state of the algorithm.  cwnd has been initialized. */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Return the slow start threshold after a congestion event */
+
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+
+  /* Grow cwnd in congestion avoidance when 'acked' bytes are ACKed */
+
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+};
+#endif
+
 /* Support for listen backlog:
  *
  *   struct tcp_blcontainer_s describes one backlogged connection
@@ -344,6 +464,15 @@ extern "C"
 
 EXTERN struct net_driver_s *g_netdevices;
 
+#ifdef CONFIG_NET_TCP_CC
+/* The congestion avoidance algorithms */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1106,6 +1235,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device that received the data
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1122,7 +1252,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 
 /****************************************************************************
@@ -1430,14 +1561,18 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
  *   Calculate the TCP receive window for the specified device.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The TCP connection that will advertise the window.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value of the TCP receive window to use.  This is the value of the
+ *   window field of the TCP header, scaled if window scaling is in effect
+ *   for the connection.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn);
 
 /****************************************************************************
  * Name: psock_tcp_cansend
@@ -1552,6 +1687,268 @@ void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb);
 int tcp_wrbuffer_test(void);
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Process the SACK option of a received ACK.  Each write buffer in the
+ *   un-ACKed queue that is entirely covered by a SACK block is marked as
+ *   selectively ACKed so that it is not retransmitted on the next
+ *   retransmission timeout.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received TCP packet.
+ *   conn  - The TCP connection of the packet.
+ *   iplen - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_input(FAR struct net_driver_s *dev,
+                    FAR struct tcp_conn_s *conn, unsigned int iplen);
+#endif
+
+/****************************************************************************
+ * Name: tcp_rtt_init
+ *
+ * Description:
+ *   Initialize the round-trip time estimation of a new connection.  The
+ *   retransmission time-out is set to its initial value of TCP_RTO
+ *   half-seconds and the retransmission timer is stopped.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.  The initial send sequence number of the
+ *   connection has been chosen.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+void tcp_rtt_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_rtt_send
+ *
+ * Description:
+ *   Account for a segment that occupies sequence space and is about to be
+ *   sent.  If no segment is being timed and this one carries new sequence
+ *   numbers, start timing it.  If it retransmits the timed segment, the
+ *   measurement is abandoned (Karn's algorithm).
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   seqno - The sequence number of the first octet of the segment
+ *   len   - The sequence space of the segment, including SYN and FIN
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+void tcp_rtt_send(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                  uint32_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_rtt_update
+ *
+ * Description:
+ *   Take a round-trip time sample if the acknowledgement covers the timed
+ *   segment and update the smoothed round-trip time, its variation and the
+ *   retransmission time-out as described in RFC 6298.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackseq - The acknowledgement number of the incoming segment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+void tcp_rtt_update(FAR struct tcp_conn_s *conn, uint32_t ackseq);
+#endif
+
+/****************************************************************************
+ * Name: tcp_rtx_start
+ *
+ * Description:
+ *   (Re-)start the retransmission timer of the connection.  The timer runs
+ *   for the retransmission time-out, backed off by the number of
+ *   retransmissions.  When the timer expires, the device of the connection
+ *   is polled.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+void tcp_rtx_start(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_rtx_stop
+ *
+ * Description:
+ *   Stop the retransmission timer of the connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+void tcp_rtx_stop(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_rtx_expired
+ *
+ * Description:
+ *   Check if the connection has outstanding data and its retransmission
+ *   timer has expired.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   true if the outstanding data must be retransmitted.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+bool tcp_rtx_expired(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_find
+ *
+ * Description:
+ *   Find a congestion avoidance algorithm by its name.
+ *
+ * Input Parameters:
+ *   name - The name of the algorithm.  Need not be NUL terminated.
+ *   len  - The maximum length of the name
+ *
+ * Returned Value:
+ *   The algorithm or NULL if there is no algorithm with that name.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+FAR const struct tcp_cc_ops_s *tcp_cc_find(FAR const char *name,
+                                           size_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Start congestion control when the first data is sent on the
+ *   connection.  cwnd is set to the initial window and the slow start
+ *   threshold is arbitrarily high.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection.  conn->sndseq is the sequence number of the
+ *          first data.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window when an ACK is received.  New data that is
+ *   ACKed grows the window by slow start or congestion avoidance.  The
+ *   third duplicate ACK enters fast recovery (RFC 5681) and a partial ACK
+ *   in fast recovery retransmits the next unACKed data (RFC 6582).
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection
+ *   ackno   - The acknowledgement number of the ACK
+ *   dupable - True if the ACK can be a duplicate ACK:  It carries no data.
+ *
+ * Returned Value:
+ *   True if the first unACKed data must be retransmitted now.
+ *
+ * Assumptions:
+ *   The network is locked.  conn->tx_unacked has been updated for the ACK.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool dupable);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window on a retransmission timeout:  cwnd is
+ *   set to one segment and the data is sent again in slow start.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.  conn->tx_unacked is still the amount of data
+ *   in flight.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_wrbuffer_dump
  *
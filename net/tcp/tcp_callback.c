@@ -99,7 +99,7 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        * partial packets will not be buffered.
        */
 
-      recvlen = tcp_datahandler(conn, buffer, buflen);
+      recvlen = tcp_datahandler(dev, conn, buffer, buflen);
       if (recvlen < buflen)
         {
           /* There is no handler to receive new data and there are no free
@@ -221,6 +221,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device that received the data
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -237,37 +238,49 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t buflen)
 {
   FAR struct iob_s *iob;
   int ret;
 
-  /* Try to allocate on I/O buffer to start the chain without waiting (and
-   * throttling as necessary).  If we would have to wait, then drop the
-   * packet.
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  /* If the driver received the packet into an I/O buffer, then take that
+   * I/O buffer instead of copying the data.
    */
 
-  iob = iob_tryalloc(true, IOBUSER_NET_TCP_READAHEAD);
+  iob = devif_iob_recv(dev, buffer, buflen, 0, IOBUSER_NET_TCP_READAHEAD);
   if (iob == NULL)
+#endif
     {
-      nerr("ERROR: Failed to create new I/O buffer chain\n");
-      return 0;
-    }
+      /* Try to allocate on I/O buffer to start the chain without waiting
+       * (and throttling as necessary).  If we would have to wait, then drop
+       * the packet.
+       */
 
-  /* Copy the new appdata into the I/O buffer chain (without waiting) */
+      iob = iob_tryalloc(true, IOBUSER_NET_TCP_READAHEAD);
+      if (iob == NULL)
+        {
+          nerr("ERROR: Failed to create new I/O buffer chain\n");
+          return 0;
+        }
 
-  ret = iob_trycopyin(iob, buffer, buflen, 0, true,
-                      IOBUSER_NET_TCP_READAHEAD);
-  if (ret < 0)
-    {
-      /* On a failure, iob_copyin return a negated error value but does
-       * not free any I/O buffers.
-       */
+      /* Copy the new appdata into the I/O buffer chain (without waiting) */
 
-      nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
-      return 0;
+      ret = iob_trycopyin(iob, buffer, buflen, 0, true,
+                          IOBUSER_NET_TCP_READAHEAD);
+      if (ret < 0)
+        {
+          /* On a failure, iob_copyin return a negated error value but does
+           * not free any I/O buffers.
+           */
+
+          nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n",
+               ret);
+          iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+          return 0;
+        }
     }
 
   /* Add the new I/O buffer chain to the tail of the read-ahead queue (again
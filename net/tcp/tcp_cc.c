@@ -0,0 +1,379 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Sequence number comparison, modulo 2^32 */
+
+#define TCP_SEQ_GT(a, b)   ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GE(a, b)   ((int32_t)((a) - (b)) >= 0)
+
+/* The number of duplicate ACKs that trigger a fast retransmit */
+
+#define TCP_CC_DUPTHRESH   3
+
+/* The initial window (RFC 5681):  Up to four segments, depending on the
+ * MSS.
+ */
+
+#define TCP_CC_IW(mss)     ((mss) > 2190 ? 2 * (mss) : \
+                            (mss) > 1095 ? 3 * (mss) : 4 * (mss))
+
+/* The largest congestion window.  This is the largest window that can be
+ * advertised with window scaling.
+ */
+
+#define TCP_CC_MAXWND      (65535ul << 14)
+
+#define TCP_CC_NALGORITHMS (sizeof(g_tcp_cc) / sizeof(g_tcp_cc[0]))
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void     newreno_init(FAR struct tcp_conn_s *conn);
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn);
+static void     newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All of the congestion avoidance algorithms that can be selected */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc[] =
+{
+  &g_tcp_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cubic,
+#endif
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_newreno =
+{
+  "newreno",                    /* name */
+  newreno_init,                 /* init */
+  newreno_ssthresh,             /* ssthresh */
+  newreno_cong_avoid            /* cong_avoid */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_init
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn)
+{
+  /* NewReno has no state of its own */
+}
+
+/****************************************************************************
+ * Name: newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max(FlightSize / 2, 2 * SMSS)  (RFC 5681, equation 4)
+ *
+ ****************************************************************************/
+
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t half = conn->tx_unacked >> 1;
+
+  return half > 2 * (uint32_t)conn->mss ? half : 2 * (uint32_t)conn->mss;
+}
+
+/****************************************************************************
+ * Name: newreno_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd by about one segment per round-trip time:
+ *   cwnd += SMSS * SMSS / cwnd for each ACK  (RFC 5681, equation 3)
+ *
+ ****************************************************************************/
+
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t incr;
+
+  incr = (uint32_t)conn->mss * conn->mss / conn->cwnd;
+  conn->cwnd += incr > 0 ? incr : 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_find
+ *
+ * Description:
+ *   Find a congestion avoidance algorithm by its name.
+ *
+ * Input Parameters:
+ *   name - The name of the algorithm.  Need not be NUL terminated.
+ *   len  - The maximum length of the name
+ *
+ * Returned Value:
+ *   The algorithm or NULL if there is no algorithm with that name.
+ *
+ ****************************************************************************/
+
+FAR const struct tcp_cc_ops_s *tcp_cc_find(FAR const char *name,
+                                           size_t len)
+{
+  int i;
+
+  len = strnlen(name, len);
+  for (i = 0; i < TCP_CC_NALGORITHMS; i++)
+    {
+      if (strlen(g_tcp_cc[i]->name) == len &&
+          strncmp(g_tcp_cc[i]->name, name, len) == 0)
+        {
+          return g_tcp_cc[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Start congestion control when the first data is sent on the
+ *   connection.  cwnd is set to the initial window and the slow start
+ *   threshold is arbitrarily high.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection.  conn->sndseq is the sequence number of the
+ *          first data.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cwnd     = TCP_CC_IW((uint32_t)conn->mss);
+  conn->ssthresh = UINT32_MAX;
+  conn->lastack  = tcp_getsequence(conn->sndseq);
+  conn->recover  = conn->lastack - 1;
+  conn->dupacks  = 0;
+  conn->recovery = false;
+
+  conn->cc->init(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window when an ACK is received.  New data that is
+ *   ACKed grows the window by slow start or congestion avoidance.  The
+ *   third duplicate ACK enters fast recovery (RFC 5681) and a partial ACK
+ *   in fast recovery retransmits the next unACKed data (RFC 6582).
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection
+ *   ackno   - The acknowledgement number of the ACK
+ *   dupable - True if the ACK can be a duplicate ACK:  It carries no data.
+ *
+ * Returned Value:
+ *   True if the first unACKed data must be retransmitted now.
+ *
+ * Assumptions:
+ *   The network is locked.  conn->tx_unacked has been updated for the ACK.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool dupable)
+{
+  uint32_t flight;
+  uint32_t acked;
+  uint32_t mss = conn->mss;
+
+  if (conn->cwnd == 0)
+    {
+      /* No data has been sent yet */
+
+      return false;
+    }
+
+  if (TCP_SEQ_GT(ackno, conn->lastack))
+    {
+      acked          = ackno - conn->lastack;
+      conn->lastack  = ackno;
+      conn->dupacks  = 0;
+
+      if (conn->recovery)
+        {
+          if (TCP_SEQ_GE(ackno, conn->recover))
+            {
+              /* A full ACK.  Deflate the window and exit fast recovery:
+               * cwnd = min(ssthresh, max(FlightSize, SMSS) + SMSS)
+               */
+
+              flight         = conn->tx_unacked > mss ?
+                               conn->tx_unacked : mss;
+              conn->cwnd     = flight + mss < conn->ssthresh ?
+                               flight + mss : conn->ssthresh;
+              conn->recovery = false;
+
+              ninfo("Exit fast recovery: cwnd=%u\n",
+                    (unsigned int)conn->cwnd);
+              return false;
+            }
+
+          /* A partial ACK.  Deflate the window by the amount of new data
+           * ACKed, add back one segment and retransmit the next unACKed
+           * data.
+           */
+
+          conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+          if (acked >= mss)
+            {
+              conn->cwnd += mss;
+            }
+
+          if (conn->cwnd < mss)
+            {
+              conn->cwnd = mss;
+            }
+
+          return true;
+        }
+
+      if (conn->cwnd < conn->ssthresh)
+        {
+          /* Slow start.  Grow by at most one segment for each ACK. */
+
+          conn->cwnd += acked < mss ? acked : mss;
+        }
+      else
+        {
+          conn->cc->cong_avoid(conn, acked);
+        }
+
+      if (conn->cwnd > TCP_CC_MAXWND)
+        {
+          conn->cwnd = TCP_CC_MAXWND;
+        }
+
+      return false;
+    }
+
+  if (ackno == conn->lastack && dupable && conn->tx_unacked > 0)
+    {
+      if (conn->recovery)
+        {
+          /* Each further duplicate ACK means that a segment has left the
+           * network.  Inflate the window.
+           */
+
+          conn->cwnd += mss;
+        }
+      else if (++conn->dupacks == TCP_CC_DUPTHRESH &&
+               TCP_SEQ_GT(ackno, conn->recover))
+        {
+          /* Fast retransmit and enter fast recovery */
+
+          conn->ssthresh = conn->cc->ssthresh(conn);
+          conn->cwnd     = conn->ssthresh + TCP_CC_DUPTHRESH * mss;
+          conn->recover  = conn->sndseq_max;
+          conn->recovery = true;
+
+          ninfo("Fast retransmit: ssthresh=%u cwnd=%u\n",
+                (unsigned int)conn->ssthresh, (unsigned int)conn->cwnd);
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window on a retransmission timeout:  cwnd is
+ *   set to one segment and the data is sent again in slow start.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.  conn->tx_unacked is still the amount of data
+ *   in flight.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cwnd == 0)
+    {
+      return;
+    }
+
+  conn->ssthresh = conn->cc->ssthresh(conn);
+  conn->cwnd     = conn->mss;
+  conn->recover  = conn->sndseq_max;
+  conn->dupacks  = 0;
+  conn->recovery = false;
+
+  ninfo("Timeout: ssthresh=%u cwnd=%u\n",
+        (unsigned int)conn->ssthresh, (unsigned int)conn->cwnd);
+}
+
+#endif /* CONFIG_NET_TCP_CC */
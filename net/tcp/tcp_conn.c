@@ -90,10 +90,187 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/* The active connections, hashed by the remote address and the local and
+ * remote ports.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_CONNHASH_SIZE];
+
+/* All connections with a local port, hashed by that port */
+
+static FAR struct tcp_conn_s *g_tcp_porthash[CONFIG_NET_TCP_CONNHASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/****************************************************************************
+ * Name: tcp_hash
+ *
+ * Description:
+ *   Return the active connection hash bucket for a remote address (folded
+ *   to 32-bits) and a pair of local and remote ports.
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_hash(uint32_t raddr, uint16_t lport,
+                                    uint16_t rport)
+{
+  uint32_t hash = raddr ^ ((uint32_t)lport << 16) ^ rport;
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash & TCP_HASH_MASK;
+}
+
+/****************************************************************************
+ * Name: tcp_ipv6_fold
+ *
+ * Description:
+ *   Fold an IPv6 address to 32-bits for tcp_hash().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *addr)
+{
+  uint32_t fold = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      fold ^= ((uint32_t)addr[i] << 16) | addr[i + 1];
+    }
+
+  return fold;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_connhash_ndx
+ *
+ * Description:
+ *   Return the active connection hash bucket of a connection.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_connhash_ndx(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_hash(conn->u.ipv4.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_hash(tcp_ipv6_fold(conn->u.ipv6.raddr), conn->lport,
+                      conn->rport);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: tcp_connhash_add
+ *
+ * Description:
+ *   Add a connection to the active connection hash table.  The addresses
+ *   and the ports of the connection must not change while it is there.
+ *
+ ****************************************************************************/
+
+static void tcp_connhash_add(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx = tcp_connhash_ndx(conn);
+
+  conn->hnext         = g_tcp_connhash[ndx];
+  g_tcp_connhash[ndx] = conn;
+}
+
+/****************************************************************************
+ * Name: tcp_connhash_remove
+ *
+ * Description:
+ *   Remove a connection from the active connection hash table.
+ *
+ ****************************************************************************/
+
+static void tcp_connhash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **prev;
+
+  for (prev = &g_tcp_connhash[tcp_connhash_ndx(conn)];
+       *prev != NULL;
+       prev = &(*prev)->hnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->hnext;
+          conn->hnext = NULL;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_porthash_remove
+ *
+ * Description:
+ *   Remove a connection from the local port hash table, if it is there.
+ *   This must be done before the local port of the connection changes.
+ *
+ ****************************************************************************/
+
+static void tcp_porthash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **prev;
+
+  for (prev = &g_tcp_porthash[TCP_PORTHASH(conn->lport)];
+       *prev != NULL;
+       prev = &(*prev)->pnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->pnext;
+          conn->pnext = NULL;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_porthash_add
+ *
+ * Description:
+ *   Add a connection to the local port hash table after its local port
+ *   was assigned.
+ *
+ ****************************************************************************/
+
+static void tcp_porthash_add(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx = TCP_PORTHASH(conn->lport);
+
+  /* Binding twice must not link the connection twice */
+
+  tcp_porthash_remove(conn);
+
+  conn->pnext         = g_tcp_porthash[ndx];
+  g_tcp_porthash[ndx] = conn;
+}
+#endif /* CONFIG_NET_TCP_CONNHASH */
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -111,13 +288,27 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_CONNHASH
   int i;
+#endif
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Check if this port number is in use by any TCP connection in the
+   * bucket of this port.
+   */
 
+  for (conn = g_tcp_porthash[TCP_PORTHASH(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+#else
   /* Check if this port number is in use by any active UIP TCP connection */
 
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+#endif
     {
+#ifndef CONFIG_NET_TCP_CONNHASH
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -162,13 +353,27 @@ static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_CONNHASH
   int i;
+#endif
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Check if this port number is in use by any TCP connection in the
+   * bucket of this port.
+   */
 
+  for (conn = g_tcp_porthash[TCP_PORTHASH(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+#else
   /* Check if this port number is in use by any active UIP TCP connection */
 
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+#endif
     {
+#ifndef CONFIG_NET_TCP_CONNHASH
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -339,10 +544,18 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Only the connections in the bucket of this segment can match */
+
+  conn       = g_tcp_connhash[tcp_hash(srcipaddr, tcp->destport,
+                                       tcp->srcport)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -378,7 +591,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -406,10 +623,18 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Only the connections in the bucket of this segment can match */
+
+  conn       = g_tcp_connhash[tcp_hash(tcp_ipv6_fold(*srcipaddr),
+                                       tcp->destport, tcp->srcport)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -445,7 +670,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -493,6 +722,9 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   conn->lport = htons(port);
   net_ipv4addr_copy(conn->u.ipv4.laddr, addr->sin_addr.s_addr);
+#ifdef CONFIG_NET_TCP_CONNHASH
+  tcp_porthash_add(conn);
+#endif
 
   /* Find the device that can receive packets on the network associated with
    * this local address.
@@ -507,6 +739,9 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      tcp_porthash_remove(conn);
+#endif
       conn->lport = 0;
       net_ipv4addr_copy(conn->u.ipv4.laddr, INADDR_ANY);
       return ret;
@@ -560,6 +795,9 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   conn->lport = htons(port);
   net_ipv6addr_copy(conn->u.ipv6.laddr, addr->sin6_addr.in6_u.u6_addr16);
+#ifdef CONFIG_NET_TCP_CONNHASH
+  tcp_porthash_add(conn);
+#endif
 
   /* Find the device that can receive packets on the network
    * associated with this local address.
@@ -574,6 +812,9 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      tcp_porthash_remove(conn);
+#endif
       conn->lport = 0;
       net_ipv6addr_copy(conn->u.ipv6.laddr, g_ipv6_unspecaddr);
       return ret;
@@ -733,6 +974,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       conn->keepidle      = 2 * DSEC_PER_HOUR;
       conn->keepintvl     = 2 * DSEC_PER_SEC;
       conn->keepcnt       = 3;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+      conn->cc            = TCP_CC_DEFAULT;
 #endif
     }
 
@@ -783,8 +1027,24 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONNHASH
+      tcp_connhash_remove(conn);
+#endif
     }
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  /* Remove the connection from the local port hash table */
+
+  tcp_porthash_remove(conn);
+#endif
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+  /* Stop the retransmission timer */
+
+  tcp_rtx_stop(conn);
+  work_cancel(LPWORK, &conn->rtx_work);
+#endif
+
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_queue(&conn->readahead, IOBUSER_NET_TCP_READAHEAD);
@@ -1006,10 +1266,12 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 
       /* Fill in the necessary fields for the new connection. */
 
+#ifndef CONFIG_NET_TCP_HIRES_RTO
       conn->rto           = TCP_RTO;
-      conn->timer         = TCP_RTO;
       conn->sa            = 0;
       conn->sv            = 4;
+#endif
+      conn->timer         = TCP_RTO;
       conn->nrtx          = 0;
       conn->lport         = tcp->destport;
       conn->rport         = tcp->srcport;
@@ -1017,6 +1279,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 
       tcp_initsequence(conn->sndseq);
       conn->tx_unacked    = 1;
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+      tcp_rtt_init(conn);
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
       conn->expired       = 0;
       conn->isn           = 0;
@@ -1044,6 +1309,10 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONNHASH
+      tcp_porthash_add(conn);
+      tcp_connhash_add(conn);
+#endif
     }
 
   return conn;
@@ -1284,9 +1553,24 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->tx_unacked = 1;    /* TCP length of the SYN is one. */
   conn->nrtx       = 0;
   conn->timer      = 1;    /* Send the SYN next time around. */
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+  tcp_rtt_init(conn);
+
+  /* The retransmission timer expires immediately.  The SYN will be sent
+   * on the next timer poll of the device.
+   */
+
+  conn->rtx_time   = clock_systime_ticks();
+  conn->rtx_ticks  = 0;
+  conn->rtx_armed  = true;
+#else
   conn->rto        = TCP_RTO;
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
+#endif
+#ifdef CONFIG_NET_TCP_CONNHASH
+  tcp_porthash_remove(conn);
+#endif
   conn->lport      = htons((uint16_t)port);
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
@@ -1309,6 +1593,10 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONNHASH
+  tcp_porthash_add(conn);
+  tcp_connhash_add(conn);
+#endif
   ret = OK;
 
 errout_with_lock:
@@ -0,0 +1,273 @@
+/****************************************************************************
+ * net/tcp/tcp_cubic.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+
+#include "tcp/tcp.h"
+
+#if defined(CONFIG_NET_TCP_CC) && defined(CONFIG_NET_TCP_CC_CUBIC)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The constants of RFC 8312 are C = 0.4 and beta_cubic = 0.7.
+ *
+ * With the window W in segments and the time t in milliseconds,
+ * C * t^3 = 4 * t^3 / 10^10 segments = 4 * t^3 / 10^7 milli-segments.
+ */
+
+#define CUBIC_BETA_NUM       7
+#define CUBIC_BETA_DEN       10
+
+/* Larger differences from K do not change the result in practice.  The
+ * limit keeps the cube well inside 64 bits.
+ */
+
+#define CUBIC_TMAX           1000000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void     cubic_init(FAR struct tcp_conn_s *conn);
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn);
+static void     cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cubic =
+{
+  "cubic",                      /* name */
+  cubic_init,                   /* init */
+  cubic_ssthresh,               /* ssthresh */
+  cubic_cong_avoid              /* cong_avoid */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b   = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cubic_wmax  = 0;
+  conn->cubic_west  = 0;
+  conn->cubic_k     = 0;
+  conn->cubic_epoch = 0;
+}
+
+/****************************************************************************
+ * Name: cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window before the reduction and reduce it by beta_cubic.
+ *   With fast convergence, W_max is reduced further if the window did not
+ *   grow back to the last W_max, leaving bandwidth to new flows.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t ssthresh;
+
+  if (conn->cwnd < conn->cubic_wmax)
+    {
+      /* W_max = cwnd * (1 + beta_cubic) / 2 */
+
+      conn->cubic_wmax = (uint32_t)((uint64_t)conn->cwnd *
+                                    (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+                                    (2 * CUBIC_BETA_DEN));
+    }
+  else
+    {
+      conn->cubic_wmax = conn->cwnd;
+    }
+
+  /* Start a new congestion avoidance period on the next ACK */
+
+  conn->cubic_epoch = 0;
+
+  ssthresh = (uint32_t)((uint64_t)conn->cwnd * CUBIC_BETA_NUM /
+                        CUBIC_BETA_DEN);
+  return ssthresh > 2 * (uint32_t)conn->mss ?
+         ssthresh : 2 * (uint32_t)conn->mss;
+}
+
+/****************************************************************************
+ * Name: cubic_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd towards W_cubic(t) = C * (t - K)^3 + W_max, or towards the
+ *   window that standard TCP would have if that is larger (the TCP-friendly
+ *   region).
+ *
+ ****************************************************************************/
+
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t mss = conn->mss;
+  uint64_t target;
+  uint64_t offset;
+  uint32_t incr;
+  clock_t now;
+  int64_t t;
+
+  now = clock_systime_ticks();
+  if (conn->cubic_epoch == 0)
+    {
+      /* The first ACK after a congestion event.  Zero marks an epoch that
+       * has not started.
+       */
+
+      conn->cubic_epoch = now != 0 ? now : 1;
+
+      if (conn->cwnd < conn->cubic_wmax)
+        {
+          /* K = cbrt((W_max - cwnd) / C), in milliseconds */
+
+          conn->cubic_k = cubic_cbrt((uint64_t)(conn->cubic_wmax -
+                                                conn->cwnd) *
+                                     1000 / mss * 2500000);
+        }
+      else
+        {
+          conn->cubic_k    = 0;
+          conn->cubic_wmax = conn->cwnd;
+        }
+
+      conn->cubic_west = conn->cwnd;
+    }
+
+  /* The time since the start of the epoch, plus one round-trip time when
+   * it is known:  The target is the window one RTT from now.
+   */
+
+  t = TICK2MSEC(now - conn->cubic_epoch);
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+  t += conn->srtt >> 3;
+#endif
+  t -= conn->cubic_k;
+
+  if (t > CUBIC_TMAX)
+    {
+      t = CUBIC_TMAX;
+    }
+  else if (t < -CUBIC_TMAX)
+    {
+      t = -CUBIC_TMAX;
+    }
+
+  /* W_cubic(t) in bytes */
+
+  offset = (uint64_t)(t < 0 ? -t : t);
+  offset = 4 * offset * offset * offset / 10000000 * mss / 1000;
+
+  if (t >= 0)
+    {
+      target = conn->cubic_wmax + offset;
+    }
+  else if (offset < conn->cubic_wmax)
+    {
+      target = conn->cubic_wmax - offset;
+    }
+  else
+    {
+      target = mss;
+    }
+
+  /* Standard TCP grows by 3 * (1 - beta) / (1 + beta) = 9 / 17 segments
+   * in each round-trip time.
+   */
+
+  conn->cubic_west += (uint32_t)((uint64_t)acked * mss * 9 /
+                                 (17 * (uint64_t)conn->cwnd));
+  if (target < conn->cubic_west)
+    {
+      target = conn->cubic_west;
+    }
+
+  /* cwnd grows by (target - cwnd) / cwnd for each segment ACKed, but by at
+   * most half of the data ACKed.  So it grows by at most 50% in each
+   * round-trip time.
+   */
+
+  if (target > conn->cwnd)
+    {
+      if (target > 2 * (uint64_t)conn->cwnd)
+        {
+          target = 2 * (uint64_t)conn->cwnd;
+        }
+
+      incr = (uint32_t)((target - conn->cwnd) * acked / conn->cwnd);
+      if (incr > (acked >> 1))
+        {
+          incr = acked >> 1;
+        }
+
+      conn->cwnd += incr > 0 ? incr : 1;
+    }
+}
+
+#endif /* CONFIG_NET_TCP_CC && CONFIG_NET_TCP_CC_CUBIC */
@@ -41,6 +41,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -97,9 +98,10 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_HIRES_RTO) || \
+    defined(CONFIG_NET_TCP_CC)
+  /* Keep alive options, TCP_INFO and TCP_CONGESTION are the only TCP
+   * protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -120,10 +122,11 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
+  /* Handle the Keep-Alive, TCP_INFO and TCP_CONGESTION options */
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -152,12 +155,14 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret                = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
 
       case TCP_NODELAY:  /* Avoid coalescing of small segments. */
         nerr("ERROR: TCP_NODELAY not supported\n");
         ret = -ENOSYS;
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (*value_len < sizeof(struct timeval))
           {
@@ -238,6 +243,67 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret              = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#if defined(CONFIG_NET_TCP_HIRES_RTO) || defined(CONFIG_NET_TCP_CC)
+      case TCP_INFO:      /* Connection information */
+        if (*value_len < sizeof(struct tcp_info))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            FAR struct tcp_info *info = (FAR struct tcp_info *)value;
+
+            /* Take a consistent snapshot of the connection state */
+
+            memset(info, 0, sizeof(struct tcp_info));
+
+            net_lock();
+            info->tcpi_state       = conn->tcpstateflags & TCP_STATE_MASK;
+            info->tcpi_retransmits = conn->nrtx;
+            info->tcpi_snd_mss     = conn->mss;
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+            /* The RTT estimates are kept in milliseconds, scaled by 8 and
+             * by 4.
+             */
+
+            info->tcpi_rto         = conn->rto * USEC_PER_MSEC;
+            info->tcpi_rtt         = (conn->srtt * USEC_PER_MSEC) >> 3;
+            info->tcpi_rttvar      = (conn->rttvar * USEC_PER_MSEC) >> 2;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            if (conn->mss > 0)
+              {
+                info->tcpi_snd_ssthresh = conn->ssthresh / conn->mss;
+                info->tcpi_snd_cwnd     = conn->cwnd / conn->mss;
+              }
+
+#endif
+            net_unlock();
+
+            *value_len             = sizeof(struct tcp_info);
+            ret                    = OK;
+          }
+        break;
+#endif /* CONFIG_NET_TCP_HIRES_RTO || CONFIG_NET_TCP_CC */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        if (*value_len < 1)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            /* Return the name, truncated to the size of the buffer */
+
+            strlcpy((FAR char *)value, conn->cc->name, *value_len);
+            *value_len = strlen((FAR char *)value) + 1;
+            ret        = OK;
+          }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -248,7 +314,8 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_HIRES_RTO ||
+        * CONFIG_NET_TCP_CC */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
@@ -72,6 +72,125 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_parse_option
+ *
+ * Description:
+ *   Parse the options of a received SYN or SYN-ACK segment.  The MSS option
+ *   limits the segment size of the connection.  The window scale and the
+ *   SACK-permitted options enable those features if they are supported.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received TCP packet.
+ *   conn  - The TCP connection of the packet.
+ *   iplen - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_parse_option(FAR struct net_driver_s *dev,
+                             FAR struct tcp_conn_s *conn,
+                             unsigned int iplen)
+{
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int hdrlen;
+  uint16_t tmp16;
+  uint8_t opt;
+  int i;
+
+  tcp    = (FAR struct tcp_hdr_s *)&dev->d_buf[iplen + NET_LL_HDRLEN(dev)];
+  hdrlen = iplen + TCP_HDRLEN + NET_LL_HDRLEN(dev);
+
+  if ((tcp->tcpoffset & 0xf0) <= 0x50)
+    {
+      /* There are no options */
+
+      return;
+    }
+
+  for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
+    {
+      opt = dev->d_buf[hdrlen + i];
+      if (opt == TCP_OPT_END)
+        {
+          /* End of options. */
+
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          /* NOP option. */
+
+          ++i;
+        }
+      else if (opt == TCP_OPT_MSS &&
+               dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
+        {
+          uint16_t tcp_mss = TCP_MSS(dev, iplen);
+
+          /* An MSS option with the right option length. */
+
+          tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
+                   (uint16_t)dev->d_buf[hdrlen + 3 + i];
+          conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+
+          i += TCP_OPT_MSS_LEN;
+        }
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      else if (opt == TCP_OPT_WS &&
+               dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
+        {
+          /* A window scale option with the right option length.  Larger
+           * shift counts than 14 must be treated as 14 (RFC 7323).
+           */
+
+          conn->snd_scale = dev->d_buf[hdrlen + 2 + i];
+          if (conn->snd_scale > TCP_WS_MAXSHIFT)
+            {
+              conn->snd_scale = TCP_WS_MAXSHIFT;
+            }
+
+          conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+          conn->wscale    = true;
+
+          i += TCP_OPT_WS_LEN;
+        }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+      else if (opt == TCP_OPT_SACK_PERM &&
+               dev->d_buf[hdrlen + 1 + i] == TCP_OPT_SACK_PERM_LEN)
+        {
+          /* The peer accepts selective acknowledgements */
+
+          conn->sack = true;
+          i += TCP_OPT_SACK_PERM_LEN;
+        }
+#endif
+      else
+        {
+          /* All other options have a length field, so that we
+           * easily can skip past them.
+           */
+
+          if (dev->d_buf[hdrlen + 1 + i] == 0)
+            {
+              /* If the length field is zero, the options are
+               * malformed and we don't process them further.
+               */
+
+              break;
+            }
+
+          i += dev->d_buf[hdrlen + 1 + i];
+        }
+    }
+}
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -97,13 +216,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   FAR struct tcp_hdr_s *tcp;
   FAR struct tcp_conn_s *conn = NULL;
   unsigned int tcpiplen;
-  unsigned int hdrlen;
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
-  uint8_t  opt;
   int      len;
-  int      i;
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -127,10 +243,6 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcpiplen = iplen + TCP_HDRLEN;
 
-  /* Get the size of the link layer header, the IP and TCP header */
-
-  hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
-
   /* Start of TCP input header processing code. */
 
   if (tcp_chksum(dev) != 0xffff)
@@ -239,59 +351,9 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP MSS and window scale options, if present. */
 
-          if ((tcp->tcpoffset & 0xf0) > 0x50)
-            {
-              for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                {
-                  opt = dev->d_buf[hdrlen + i];
-                  if (opt == TCP_OPT_END)
-                    {
-                      /* End of options. */
-
-                      break;
-                    }
-                  else if (opt == TCP_OPT_NOOP)
-                    {
-                      /* NOP option. */
-
-                      ++i;
-                    }
-                  else if (opt == TCP_OPT_MSS &&
-                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                    {
-                      uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                      /* An MSS option with the right option length. */
-
-                      tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
-                               (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                      /* And we are done processing options. */
-
-                      break;
-                    }
-                  else
-                    {
-                      /* All other options have a length field, so that we
-                       * easily can skip past them.
-                       */
-
-                      if (dev->d_buf[hdrlen + 1 + i] == 0)
-                        {
-                          /* If the length field is zero, the options are
-                           * malformed and we don't process them further.
-                           */
-
-                          break;
-                        }
-
-                      i += dev->d_buf[hdrlen + 1 + i];
-                    }
-                }
-            }
+          tcp_parse_option(dev, conn, iplen);
 
           /* Our response will be a SYNACK. */
 
@@ -327,6 +389,25 @@ found:
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window is never scaled in a segment with the SYN bit set */
+
+  if ((tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_scale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Update the write buffer scoreboard from the SACK blocks, if any */
+
+  if (conn->sack && (tcp->flags & TCP_ACK) != 0 &&
+      (tcp->tcpoffset & 0xf0) > 0x50)
+    {
+      tcp_sack_input(dev, conn, iplen);
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -466,6 +547,9 @@ found:
     {
       uint32_t unackseq;
       uint32_t ackseq;
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+      uint32_t prevunacked = conn->tx_unacked;
+#endif
 
       /* The next sequence number is equal to the current sequence
        * number (sndseq) plus the size of the outstanding, unacknowledged
@@ -523,6 +607,35 @@ found:
 
       ninfo("sndseq: %08x->%08x unackseq: %08x new tx_unacked: %d\n",
           tcp_getsequence(conn->sndseq), ackseq, unackseq, conn->tx_unacked);
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+      /* Only an ACK of new data says anything about the round-trip time.
+       * Take a sample if it covers the timed segment and clear the
+       * backoff.
+       */
+
+      if (conn->tx_unacked < prevunacked)
+        {
+          tcp_rtt_update(conn, ackseq);
+
+          conn->nrtx = 0;
+
+          /* Restart the retransmission timer for the data that is still
+           * outstanding.
+           */
+
+          if (conn->tx_unacked > 0)
+            {
+              tcp_rtx_start(conn);
+            }
+          else
+            {
+              tcp_rtx_stop(conn);
+            }
+        }
+
+      tcp_setsequence(conn->sndseq, ackseq);
+#else
       tcp_setsequence(conn->sndseq, ackseq);
 
       /* Do RTT estimation, unless we have done retransmissions. */
@@ -546,13 +659,14 @@ found:
           conn->rto = (conn->sa >> 3) + conn->sv;
         }
 
-      /* Set the acknowledged flag. */
-
-      flags |= TCP_ACKDATA;
-
       /* Reset the retransmission timer. */
 
       conn->timer = conn->rto;
+#endif
+
+      /* Set the acknowledged flag. */
+
+      flags |= TCP_ACKDATA;
     }
 
   /* Do different things depending on in what state the connection is. */
@@ -646,60 +760,9 @@ found:
         if ((flags & TCP_ACKDATA) != 0 &&
             (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+            /* Parse the TCP MSS and window scale options, if present. */
 
-            if ((tcp->tcpoffset & 0xf0) > 0x50)
-              {
-                for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                  {
-                    opt = dev->d_buf[hdrlen + i];
-                    if (opt == TCP_OPT_END)
-                      {
-                        /* End of options. */
-
-                        break;
-                      }
-                    else if (opt == TCP_OPT_NOOP)
-                      {
-                        /* NOP option. */
-
-                        ++i;
-                      }
-                    else if (opt == TCP_OPT_MSS &&
-                              dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                      {
-                        uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                        /* An MSS option with the right option length. */
-
-                        tmp16 =
-                          (dev->d_buf[hdrlen + 2 + i] << 8) |
-                          dev->d_buf[hdrlen + 3 + i];
-                        conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                        /* And we are done processing options. */
-
-                        break;
-                      }
-                    else
-                      {
-                        /* All other options have a length field, so that we
-                         * easily can skip past them.
-                         */
-
-                        if (dev->d_buf[hdrlen + 1 + i] == 0)
-                          {
-                            /* If the length field is zero, the options are
-                             * malformed and we don't process them further.
-                             */
-
-                            break;
-                          }
-
-                        i += dev->d_buf[hdrlen + 1 + i];
-                      }
-                  }
-              }
+            tcp_parse_option(dev, conn, iplen);
 
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
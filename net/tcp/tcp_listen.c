@@ -58,9 +58,18 @@
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/* The listening connections, hashed by their local port.  The number of
+ * listeners is still limited to CONFIG_NET_MAX_LISTENPORTS.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_listenhash[CONFIG_NET_TCP_CONNHASH_SIZE];
+static int g_tcp_nlisteners;
+#else
 /* The tcp_listenports list all currently listening ports. */
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -83,17 +92,29 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno, uint8_t domain)
 FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 #endif
 {
+#ifdef CONFIG_NET_TCP_CONNHASH
+  FAR struct tcp_conn_s *conn;
+
+  /* Examine each listener in the bucket of this port */
+
+  for (conn = g_tcp_listenhash[TCP_PORTHASH(portno)];
+       conn != NULL;
+       conn = conn->lnext)
+#else
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
 
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+#endif
     {
+#ifndef CONFIG_NET_TCP_CONNHASH
       /* Is this slot assigned?  If so, does the connection have the same
        * local port number?
        */
 
       FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       if (conn && conn->lport == portno && conn->domain == domain)
 #else
@@ -130,10 +151,20 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 void tcp_listen_initialize(void)
 {
   int ndx;
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+  for (ndx = 0; ndx < CONFIG_NET_TCP_CONNHASH_SIZE; ndx++)
+    {
+      g_tcp_listenhash[ndx] = NULL;
+    }
+
+  g_tcp_nlisteners = 0;
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       tcp_listenports[ndx] = NULL;
     }
+#endif
 }
 
 /****************************************************************************
@@ -149,10 +180,29 @@ void tcp_listen_initialize(void)
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONNHASH
+  FAR struct tcp_conn_s **prev;
+#else
   int ndx;
+#endif
   int ret = -EINVAL;
 
   net_lock();
+#ifdef CONFIG_NET_TCP_CONNHASH
+  for (prev = &g_tcp_listenhash[TCP_PORTHASH(conn->lport)];
+       *prev != NULL;
+       prev = &(*prev)->lnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->lnext;
+          conn->lnext = NULL;
+          g_tcp_nlisteners--;
+          ret = OK;
+          break;
+        }
+    }
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       if (tcp_listenports[ndx] == conn)
@@ -162,6 +212,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
           break;
         }
     }
+#endif
 
   net_unlock();
   return ret;
@@ -209,6 +260,18 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -ENOBUFS; /* Assume failure */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      /* Add the connection to the bucket of its port */
+
+      if (g_tcp_nlisteners < CONFIG_NET_MAX_LISTENPORTS)
+        {
+          ndx                   = TCP_PORTHASH(conn->lport);
+          conn->lnext           = g_tcp_listenhash[ndx];
+          g_tcp_listenhash[ndx] = conn;
+          g_tcp_nlisteners++;
+          ret = OK;
+        }
+#else
       /* Search all slots until an available slot is found */
 
       for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
@@ -224,6 +287,7 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+#endif
     }
 
   net_unlock();
@@ -45,6 +45,7 @@
 #include <poll.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
 
@@ -122,14 +123,19 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
 
       if (eventset != 0)
         {
-          /* Stop further callbacks */
+          /* Stop further callbacks, unless the poll is persistent (epoll)
+           * and must see every event until it is torn down.
+           */
 
-          info->cb->flags   = 0;
-          info->cb->priv    = NULL;
-          info->cb->event   = NULL;
+          if (info->fds->cb == NULL)
+            {
+              info->cb->flags   = 0;
+              info->cb->priv    = NULL;
+              info->cb->event   = NULL;
+            }
 
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -297,7 +303,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 errout_with_lock:
@@ -63,18 +63,24 @@
  *   Calculate the TCP receive window for the specified device.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The TCP connection that will advertise the window.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value of the TCP receive window to use.  This is the value of the
+ *   window field of the TCP header, scaled if window scaling is in effect
+ *   for the connection.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
 {
   uint16_t iplen;
   uint16_t mss;
-  uint16_t recvwndo;
+  uint32_t recvwndo;
+  uint32_t maxwndo;
+  uint8_t shift = 0;
   int niob_avail;
   int nqentry_avail;
 
@@ -155,14 +161,10 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        */
 
       rwnd = (niob_avail * CONFIG_IOB_BUFSIZE) + mss;
-      if (rwnd > UINT16_MAX)
-        {
-          rwnd = UINT16_MAX;
-        }
 
       /* Save the new receive window size */
 
-      recvwndo = (uint16_t)rwnd;
+      recvwndo = rwnd;
     }
   else /* nqentry_avail == 0 || niob_avail == 0 */
     {
@@ -177,5 +179,30 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
       recvwndo = mss;
     }
 
-  return recvwndo;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window is never scaled in a SYN or SYN-ACK segment.  Those are the
+   * only segments sent in the SYN_SENT and SYN_RCVD states.
+   */
+
+  if ((conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_SENT &&
+      (conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_RCVD)
+    {
+      shift = conn->rcv_scale;
+    }
+#endif
+
+  /* Limit the window to the largest that can be advertised */
+
+  maxwndo = (uint32_t)UINT16_MAX << shift;
+  if (recvwndo > maxwndo)
+    {
+      recvwndo = maxwndo;
+    }
+
+  /* The scaled window is rounded down, but an open window must not be
+   * advertised as closed.
+   */
+
+  recvwndo >>= shift;
+  return recvwndo > 0 ? (uint16_t)recvwndo : 1;
 }
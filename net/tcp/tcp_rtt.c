@@ -0,0 +1,380 @@
+/****************************************************************************
+ * net/tcp/tcp_rtt.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The initial retransmission time-out (units: milliseconds) */
+
+#define TCP_RTO_INIT  (TCP_RTO * MSEC_PER_HSEC)
+
+/* The clock granularity (units: milliseconds) */
+
+#define TCP_RTT_G     (TICK2MSEC(1) > 0 ? TICK2MSEC(1) : 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_rtx_work
+ *
+ * Description:
+ *   Poll the device of the connection so that the outstanding data is
+ *   retransmitted.  This runs on the work queue.
+ *
+ ****************************************************************************/
+
+static void tcp_rtx_work(FAR void *arg)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)arg;
+
+  net_lock();
+
+  /* The timer may have been stopped or restarted in the meantime.  Then
+   * the poll is harmless.
+   */
+
+  if (conn->rtx_armed && conn->dev != NULL)
+    {
+      netdev_txnotify_dev(conn->dev);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: tcp_rtx_timeout
+ *
+ * Description:
+ *   Retransmission timer watchdog handler.
+ *
+ * Assumptions:
+ *   This function is called from the wdog timer handler which runs in the
+ *   context of the timer interrupt handler.
+ *
+ ****************************************************************************/
+
+static void tcp_rtx_timeout(wdparm_t arg)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)arg;
+  int ret;
+
+  ret = work_queue(LPWORK, &conn->rtx_work, tcp_rtx_work, conn, 0);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to queue retransmission work: %d\n", ret);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_rtt_init
+ *
+ * Description:
+ *   Initialize the round-trip time estimation of a new connection.  The
+ *   retransmission time-out is set to its initial value of TCP_RTO
+ *   half-seconds and the retransmission timer is stopped.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.  The initial send sequence number of the
+ *   connection has been chosen.
+ *
+ ****************************************************************************/
+
+void tcp_rtt_init(FAR struct tcp_conn_s *conn)
+{
+  tcp_rtx_stop(conn);
+
+  conn->srtt       = 0;
+  conn->rttvar     = 0;
+  conn->rto        = TCP_RTO_INIT;
+  conn->rtt_sndnxt = tcp_getsequence(conn->sndseq);
+  conn->rtt_timing = false;
+}
+
+/****************************************************************************
+ * Name: tcp_rtt_send
+ *
+ * Description:
+ *   Account for a segment that occupies sequence space and is about to be
+ *   sent.  If no segment is being timed and this one carries new sequence
+ *   numbers, start timing it.  If it retransmits the timed segment, the
+ *   measurement is abandoned (Karn's algorithm).
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   seqno - The sequence number of the first octet of the segment
+ *   len   - The sequence space of the segment, including SYN and FIN
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_rtt_send(FAR struct tcp_conn_s *conn, uint32_t seqno,
+                  uint32_t len)
+{
+  uint32_t endseq = seqno + len;
+
+  /* A segment that starts before the end of the timed segment resends
+   * some of it.  The acknowledgement could then belong to either
+   * transmission, so the measurement is useless.
+   */
+
+  if (conn->rtt_timing && (int32_t)(seqno - conn->rtt_seq) < 0)
+    {
+      conn->rtt_timing = false;
+    }
+
+  /* Only time a segment that has never been sent before */
+
+  if ((int32_t)(endseq - conn->rtt_sndnxt) > 0)
+    {
+      if (!conn->rtt_timing && (int32_t)(seqno - conn->rtt_sndnxt) >= 0)
+        {
+          conn->rtt_seq    = endseq;
+          conn->rtt_time   = clock_systime_ticks();
+          conn->rtt_timing = true;
+        }
+
+      conn->rtt_sndnxt = endseq;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_rtt_update
+ *
+ * Description:
+ *   Take a round-trip time sample if the acknowledgement covers the timed
+ *   segment and update the smoothed round-trip time, its variation and the
+ *   retransmission time-out as described in RFC 6298.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackseq - The acknowledgement number of the incoming segment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_rtt_update(FAR struct tcp_conn_s *conn, uint32_t ackseq)
+{
+  uint32_t rtt;
+  uint32_t var;
+  int32_t delta;
+
+  if (!conn->rtt_timing || (int32_t)(ackseq - conn->rtt_seq) < 0)
+    {
+      return;
+    }
+
+  conn->rtt_timing = false;
+
+  rtt = TICK2MSEC(clock_systime_ticks() - conn->rtt_time);
+  if (rtt == 0)
+    {
+      /* Less than one tick.  Zero is reserved for "no sample yet" */
+
+      rtt = 1;
+    }
+
+  if (conn->srtt == 0)
+    {
+      /* The first sample:  SRTT = R, RTTVAR = R / 2 */
+
+      conn->srtt   = rtt << 3;
+      conn->rttvar = rtt << 1;
+    }
+  else
+    {
+      /* RTTVAR = 3/4 * RTTVAR + 1/4 * |SRTT - R| and
+       * SRTT = 7/8 * SRTT + 1/8 * R.  Both are kept scaled so that this
+       * is done with shifts.
+       */
+
+      delta         = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+      conn->srtt   += delta;
+      if (delta < 0)
+        {
+          delta = -delta;
+        }
+
+      delta        -= (int32_t)(conn->rttvar >> 2);
+      conn->rttvar += delta;
+    }
+
+  /* RTO = SRTT + max(G, 4 * RTTVAR).  The scaled rttvar is already
+   * 4 * RTTVAR.
+   */
+
+  var = conn->rttvar > TCP_RTT_G ? conn->rttvar : TCP_RTT_G;
+  conn->rto = (conn->srtt >> 3) + var;
+
+  if (conn->rto < TCP_RTO_MIN)
+    {
+      conn->rto = TCP_RTO_MIN;
+    }
+  else if (conn->rto > TCP_RTO_MAX)
+    {
+      conn->rto = TCP_RTO_MAX;
+    }
+
+  ninfo("rtt: %u srtt: %u rttvar: %u rto: %u\n",
+        (unsigned int)rtt, (unsigned int)(conn->srtt >> 3),
+        (unsigned int)(conn->rttvar >> 2), (unsigned int)conn->rto);
+}
+
+/****************************************************************************
+ * Name: tcp_rtx_start
+ *
+ * Description:
+ *   (Re-)start the retransmission timer of the connection.  The timer runs
+ *   for the retransmission time-out, backed off by the number of
+ *   retransmissions.  When the timer expires, the device of the connection
+ *   is polled.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_rtx_start(FAR struct tcp_conn_s *conn)
+{
+  uint32_t rto;
+  clock_t ticks;
+
+  /* Exponential backoff */
+
+  rto = conn->rto << (conn->nrtx > 4 ? 4 : conn->nrtx);
+  if (rto > TCP_RTO_MAX)
+    {
+      rto = TCP_RTO_MAX;
+    }
+
+  ticks = MSEC2TICK(rto);
+  if (ticks == 0)
+    {
+      ticks = 1;
+    }
+
+  conn->rtx_time  = clock_systime_ticks();
+  conn->rtx_ticks = ticks;
+  conn->rtx_armed = true;
+
+  wd_start(&conn->rtx_wdog, ticks, tcp_rtx_timeout, (wdparm_t)conn);
+}
+
+/****************************************************************************
+ * Name: tcp_rtx_stop
+ *
+ * Description:
+ *   Stop the retransmission timer of the connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_rtx_stop(FAR struct tcp_conn_s *conn)
+{
+  if (conn->rtx_armed)
+    {
+      wd_cancel(&conn->rtx_wdog);
+      conn->rtx_armed = false;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_rtx_expired
+ *
+ * Description:
+ *   Check if the connection has outstanding data and its retransmission
+ *   timer has expired.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   true if the outstanding data must be retransmitted.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_rtx_expired(FAR struct tcp_conn_s *conn)
+{
+  return conn->rtx_armed && conn->tx_unacked > 0 &&
+         clock_systime_ticks() - conn->rtx_time >= conn->rtx_ticks;
+}
+
+#endif /* CONFIG_NET_TCP_HIRES_RTO */
@@ -0,0 +1,166 @@
+/****************************************************************************
+ * net/tcp/tcp_sack.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_NET_TCP_SACK)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Sequence number comparison, modulo 2^32 */
+
+#define TCP_SEQ_LE(a, b)  ((int32_t)((a) - (b)) <= 0)
+
+/* Each SACK block is a pair of 32-bit sequence numbers */
+
+#define TCP_SACK_BLOCKLEN 8
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_mark
+ *
+ * Description:
+ *   Mark each write buffer in the un-ACKed queue that lies entirely within
+ *   the SACK block [left, right).
+ *
+ ****************************************************************************/
+
+static void tcp_sack_mark(FAR struct tcp_conn_s *conn, uint32_t left,
+                          uint32_t right)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  uint32_t lastseq;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb     = (FAR struct tcp_wrbuffer_s *)entry;
+      lastseq = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
+
+      if (TCP_SEQ_LE(left, TCP_WBSEQNO(wrb)) && TCP_SEQ_LE(lastseq, right))
+        {
+          ninfo("SACK: wrb=%p seqno=%u lastseq=%u\n",
+                wrb, TCP_WBSEQNO(wrb), lastseq);
+
+          wrb->wb_sacked = true;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Process the SACK option of a received ACK.  Each write buffer in the
+ *   un-ACKed queue that is entirely covered by a SACK block is marked as
+ *   selectively ACKed so that it is not retransmitted on the next
+ *   retransmission timeout.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received TCP packet.
+ *   conn  - The TCP connection of the packet.
+ *   iplen - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_input(FAR struct net_driver_s *dev,
+                    FAR struct tcp_conn_s *conn, unsigned int iplen)
+{
+  FAR struct tcp_hdr_s *tcp;
+  FAR uint8_t *options;
+  unsigned int optlen;
+  unsigned int len;
+  unsigned int i;
+  unsigned int j;
+
+  tcp     = (FAR struct tcp_hdr_s *)&dev->d_buf[iplen + NET_LL_HDRLEN(dev)];
+  options = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  optlen  = ((tcp->tcpoffset >> 4) - 5) << 2;
+
+  for (i = 0; i < optlen; )
+    {
+      if (options[i] == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (options[i] == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+
+      /* All other options have a length field */
+
+      if (i + 1 >= optlen || options[i + 1] < 2 ||
+          i + options[i + 1] > optlen)
+        {
+          /* The options are malformed */
+
+          break;
+        }
+
+      len = options[i + 1];
+      if (options[i] == TCP_OPT_SACK)
+        {
+          /* Mark the write buffers covered by each block */
+
+          for (j = i + 2; j + TCP_SACK_BLOCKLEN <= i + len;
+               j += TCP_SACK_BLOCKLEN)
+            {
+              tcp_sack_mark(conn, tcp_getsequence(&options[j]),
+                            tcp_getsequence(&options[j + 4]));
+            }
+        }
+
+      i += len;
+    }
+}
+
+#endif /* CONFIG_NET_TCP_WRITE_BUFFERS && CONFIG_NET_TCP_SACK */
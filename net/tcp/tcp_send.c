@@ -360,7 +360,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -368,6 +368,25 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->wnd[1] = recvwndo & 0xff;
     }
 
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+  /* Time the segment for the round-trip time estimation and start the
+   * retransmission timer when a segment that occupies sequence space is
+   * sent and the timer is not already running.
+   */
+
+  if (dev->d_sndlen > 0 || (tcp->flags & (TCP_SYN | TCP_FIN)) != 0)
+    {
+      tcp_rtt_send(conn, tcp_getsequence(conn->sndseq),
+                   dev->d_sndlen +
+                   ((tcp->flags & (TCP_SYN | TCP_FIN)) != 0 ? 1 : 0));
+
+      if (!conn->rtx_armed)
+        {
+          tcp_rtx_start(conn);
+        }
+    }
+#endif
+
   /* Finish the IP portion of the message and calculate checksums */
 
   tcp_sendcomplete(dev, tcp);
@@ -573,7 +592,11 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                 uint8_t ack)
 {
   struct tcp_hdr_s *tcp;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+  FAR uint8_t *opt;
+#endif
   uint16_t tcp_mss;
+  uint16_t optlen;
 
   /* Get values that vary with the underlying IP domain */
 
@@ -619,7 +642,47 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->optdata[1] = TCP_OPT_MSS_LEN;
   tcp->optdata[2] = tcp_mss >> 8;
   tcp->optdata[3] = tcp_mss & 0xff;
-  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  optlen          = TCP_OPT_MSS_LEN;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+  /* The other options follow the MSS option, beyond struct tcp_hdr_s.
+   * Each is padded with NOPs to keep the header word-aligned.
+   */
+
+  opt = (FAR uint8_t *)tcp + TCP_HDRLEN + TCP_OPT_MSS_LEN;
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window scale option is sent in our SYN and, if the peer sent it in
+   * its SYN, in our SYN-ACK.
+   */
+
+  if ((ack & TCP_SYN) != 0 && ((ack & TCP_ACK) == 0 || conn->wscale))
+    {
+      opt[0]  = TCP_OPT_NOOP;
+      opt[1]  = TCP_OPT_WS;
+      opt[2]  = TCP_OPT_WS_LEN;
+      opt[3]  = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+      opt    += 4;
+      optlen += 4;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* The same applies to the SACK-permitted option */
+
+  if ((ack & TCP_SYN) != 0 && ((ack & TCP_ACK) == 0 || conn->sack))
+    {
+      opt[0]  = TCP_OPT_NOOP;
+      opt[1]  = TCP_OPT_NOOP;
+      opt[2]  = TCP_OPT_SACK_PERM;
+      opt[3]  = TCP_OPT_SACK_PERM_LEN;
+      optlen += 4;
+    }
+#endif
+
+  dev->d_len     += optlen - TCP_OPT_MSS_LEN;
+  tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
 
   /* Complete the common portions of the TCP message */
 
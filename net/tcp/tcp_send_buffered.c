@@ -158,6 +158,49 @@ static void psock_insert_segment(FAR struct tcp_wrbuffer_s *wrb,
     }
 }
 
+/****************************************************************************
+ * Name: psock_fast_retransmit
+ *
+ * Description:
+ *   Move the first un-ACKed write buffer back to the write queue so that it
+ *   is sent again before any other data.  Unlike a retransmission timeout,
+ *   the rest of the un-ACKed write buffers stay in flight.
+ *
+ * Input Parameters:
+ *   conn  The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+static void psock_fast_retransmit(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  uint16_t sent;
+
+  wrb = (FAR struct tcp_wrbuffer_s *)sq_remfirst(&conn->unacked_q);
+  if (wrb == NULL)
+    {
+      return;
+    }
+
+  sent = TCP_WBSENT(wrb);
+  conn->tx_unacked = conn->tx_unacked > sent ? conn->tx_unacked - sent : 0;
+  conn->sent       = conn->sent > sent ? conn->sent - sent : 0;
+
+  TCP_WBSENT(wrb) = 0;
+  ninfo("FASTRTX: wrb=%p seqno=%u pktlen=%u\n",
+        wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb));
+
+  psock_insert_segment(wrb, &conn->write_q);
+}
+#endif
+
 /****************************************************************************
  * Name: psock_writebuffer_notify
  *
@@ -317,6 +360,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)pvconn;
   FAR struct socket *psock = (FAR struct socket *)pvpriv;
+#ifdef CONFIG_NET_TCP_CC
+  bool fastrtx = false;
+#endif
 
   /* The TCP socket is connected and, hence, should be bound to a device.
    * Make sure that the polling device is the one that we are bound to.
@@ -481,6 +527,19 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Update the congestion window.  On the third duplicate ACK or on a
+       * partial ACK in fast recovery, send the first un-ACKed write buffer
+       * again right away.
+       */
+
+      if (tcp_cc_ack(conn, ackno, (flags & TCP_NEWDATA) == 0))
+        {
+          psock_fast_retransmit(conn);
+          fastrtx = true;
+        }
+#endif
     }
 
   /* Check for a loss of connection */
@@ -513,9 +572,22 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
     {
       FAR struct tcp_wrbuffer_s *wrb;
       FAR sq_entry_t *entry;
+#ifdef CONFIG_NET_TCP_SACK
+      sq_queue_t sacked;
+
+      sq_init(&sacked);
+#endif
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Collapse the congestion window while tx_unacked is still the
+       * amount of data in flight.
+       */
+
+      tcp_cc_timeout(conn);
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -600,6 +672,23 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           wrb = (FAR struct tcp_wrbuffer_s *)entry;
           uint16_t sent;
 
+#ifdef CONFIG_NET_TCP_SACK
+          /* Write buffers that the peer has selectively ACKed are not
+           * sent again.  The mark is cleared so that they are sent on the
+           * next timeout if they are still not ACKed then.  The peer may
+           * discard data that it selectively ACKed.
+           */
+
+          if (wrb->wb_sacked)
+            {
+              ninfo("REXMIT: Keeping SACKed wrb=%p\n", wrb);
+
+              wrb->wb_sacked = false;
+              sq_addfirst(entry, &sacked);
+              continue;
+            }
+#endif
+
           /* Reset the number of bytes sent sent from the write buffer */
 
           sent = TCP_WBSENT(wrb);
@@ -666,6 +755,14 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               psock_insert_segment(wrb, &conn->write_q);
             }
         }
+
+#ifdef CONFIG_NET_TCP_SACK
+      /* Put the selectively ACKed write buffers back in the un-ACKed queue,
+       * in the same order.
+       */
+
+      sq_cat(&sacked, &conn->unacked_q);
+#endif
     }
 
   /* Check if the outgoing packet is available (it may have been claimed
@@ -679,6 +776,17 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       return flags;
     }
 
+#ifdef CONFIG_NET_TCP_CC
+  /* The congestion window limits the data in flight.  A fast
+   * retransmission is sent regardless.
+   */
+
+  if (!fastrtx && conn->cwnd > 0 && conn->tx_unacked >= conn->cwnd)
+    {
+      return flags;
+    }
+#endif
+
   /* We get here if (1) not all of the data has been ACKed, (2) we have been
    * asked to retransmit data, (3) the connection is still healthy, and (4)
    * the outgoing packet is available for our use.  In this case, we are
@@ -688,7 +796,11 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
    */
 
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
+#ifdef CONFIG_NET_TCP_CC
+      ((flags & (TCP_POLL | TCP_REXMIT)) || fastrtx) &&
+#else
       (flags & (TCP_POLL | TCP_REXMIT)) &&
+#endif
       !(sq_empty(&conn->write_q)) &&
       conn->winsize > 0)
     {
@@ -721,10 +833,18 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           sndlen = conn->winsize;
         }
 
+#ifdef CONFIG_NET_TCP_CC
+      if (!fastrtx && conn->cwnd > 0 &&
+          sndlen > conn->cwnd - conn->tx_unacked)
+        {
+          sndlen = conn->cwnd - conn->tx_unacked;
+        }
+#endif
+
       ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u mss=%u "
             "winsize=%u\n",
             wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen, conn->mss,
-            conn->winsize);
+            (unsigned int)conn->winsize);
 
       /* Set the sequence number for this segment.  If we are
        * retransmitting, then the sequence number will already
@@ -745,6 +865,15 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       tcp_setsequence(conn->sndseq, TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb));
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Start congestion control with the first data */
+
+      if (conn->cwnd == 0)
+        {
+          tcp_cc_init(conn);
+        }
+#endif
+
 #ifdef NEED_IPDOMAIN_SUPPORT
       /* If both IPv4 and IPv6 support are enabled, then we will need to
        * select which one to use when generating the outgoing packet.
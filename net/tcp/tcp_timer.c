@@ -205,17 +205,33 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
         {
           /* The connection has outstanding data */
 
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+          if (!tcp_rtx_expired(conn))
+            {
+              /* Not yet expired.  Start the timer if the outstanding data
+               * was not sent by tcp_send().
+               */
+
+              if (!conn->rtx_armed)
+                {
+                  tcp_rtx_start(conn);
+                }
+            }
+#else
           if (conn->timer > hsec)
             {
               /* Will not yet decrement to zero */
 
               conn->timer -= hsec;
             }
+#endif
           else
             {
+#ifndef CONFIG_NET_TCP_HIRES_RTO
               /* Will decrement to zero */
 
               conn->timer = 0;
+#endif
 
               /* The TCP is connected and, hence, should be bound to a
                * device. Make sure that the polling device is the one that
@@ -291,6 +307,9 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                 {
                   conn->tcpstateflags = TCP_CLOSED;
                   ninfo("TCP state: TCP_CLOSED\n");
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+                  tcp_rtx_stop(conn);
+#endif
 
                   /* We call tcp_callback() with TCP_TIMEDOUT to
                    * inform the application that the connection has
@@ -307,8 +326,13 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
               /* Exponential backoff. */
 
+#ifdef CONFIG_NET_TCP_HIRES_RTO
+              (conn->nrtx)++;
+              tcp_rtx_start(conn);
+#else
               conn->timer = TCP_RTO << (conn->nrtx > 4 ? 4: conn->nrtx);
               (conn->nrtx)++;
+#endif
 
               /* Ok, so we need to retransmit. We do this differently
                * depending on which state we are in. In ESTABLISHED, we
@@ -85,6 +85,17 @@
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+#  if (CONFIG_NET_UDP_CONNHASH_SIZE & (CONFIG_NET_UDP_CONNHASH_SIZE - 1)) != 0
+#    error CONFIG_NET_UDP_CONNHASH_SIZE must be a power of two
+#  endif
+
+/* Return the port hash bucket of a local port, in either byte order */
+
+#  define UDP_PORTHASH(p) \
+     (((p) ^ ((p) >> 8)) & (CONFIG_NET_UDP_CONNHASH_SIZE - 1))
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -135,6 +146,9 @@ struct udp_conn_s
   uint8_t  boundto;       /* Index of the interface we are bound to.
                            * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #endif
+#ifdef CONFIG_NET_UDP_CONNHASH
+  FAR struct udp_conn_s *pnext; /* Next in the same port hash bucket */
+#endif
 
   /* Read-ahead buffering.
    *
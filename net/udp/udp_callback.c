@@ -98,17 +98,6 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
   FAR void  *src_addr;
   uint8_t src_addr_size;
 
-  /* Allocate on I/O buffer to start the chain (throttling as necessary).
-   * We will not wait for an I/O buffer to become available in this context.
-   */
-
-  iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
-  if (iob == NULL)
-    {
-      nerr("ERROR: Failed to create new I/O buffer chain\n");
-      return 0;
-    }
-
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -173,6 +162,30 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
     }
 #endif /* CONFIG_NET_IPv4 */
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  /* If the driver received the packet into an I/O buffer, then take that
+   * I/O buffer instead of copying the data.  The src address info is
+   * written in front of the data, over the packet headers.
+   */
+
+  iob = devif_iob_recv(dev, buffer, buflen, src_addr_size + sizeof(uint8_t),
+                       IOBUSER_NET_UDP_READAHEAD);
+  if (iob == NULL)
+#endif
+    {
+      /* Allocate on I/O buffer to start the chain (throttling as
+       * necessary).  We will not wait for an I/O buffer to become available
+       * in this context.
+       */
+
+      iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
+      if (iob == NULL)
+        {
+          nerr("ERROR: Failed to create new I/O buffer chain\n");
+          return 0;
+        }
+    }
+
   /* Copy the src address info into the I/O buffer chain.  We will not wait
    * for an I/O buffer to become available in this context.  It there is
    * any failure to allocated, the entire I/O buffer chain will be discarded.
@@ -204,10 +217,13 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
       return 0;
     }
 
-  if (buflen > 0)
-    {
-      /* Copy the new appdata into the I/O buffer chain */
+  /* Copy the new appdata into the I/O buffer chain unless it is already
+   * there.
+   */
 
+  if (buflen > 0 &&
+      iob->io_pktlen < src_addr_size + sizeof(uint8_t) + buflen)
+    {
       ret = iob_trycopyin(iob, buffer, buflen,
                           src_addr_size + sizeof(uint8_t), true,
                           IOBUSER_NET_UDP_READAHEAD);
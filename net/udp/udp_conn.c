@@ -45,7 +45,9 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_UDP)
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
@@ -74,6 +76,16 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* The range of the local port numbers selected by udp_select_port() */
+
+#define UDP_PORT_FIRST  4096
+#define UDP_PORT_END    32000
+
+#ifdef CONFIG_NET_UDP_CONNHASH
+#  define UDP_PORTMAP_NBITS  (UDP_PORT_END - UDP_PORT_FIRST)
+#  define UDP_PORTMAP_NWORDS ((UDP_PORTMAP_NBITS + 31) >> 5)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -91,6 +103,20 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+/* The connections with a local port, hashed by that port.  Each bucket is
+ * kept in the order in which the connections were bound.
+ */
+
+static FAR struct udp_conn_s *g_udp_porthash[CONFIG_NET_UDP_CONNHASH_SIZE];
+
+/* One bit for each port in the range of udp_select_port().  A bit is set
+ * while any connection is bound to that port.
+ */
+
+static uint32_t g_udp_portmap[UDP_PORTMAP_NWORDS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -110,6 +136,170 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+/****************************************************************************
+ * Name: udp_portmap_set
+ *
+ * Description:
+ *   Mark a port number (network byte order) as used or unused in the
+ *   ephemeral port bitmap.  Ports outside of the bitmap are ignored.
+ *
+ ****************************************************************************/
+
+static void udp_portmap_set(uint16_t portno, bool inuse)
+{
+  unsigned int bit = ntohs(portno);
+
+  if (bit >= UDP_PORT_FIRST && bit < UDP_PORT_END)
+    {
+      bit -= UDP_PORT_FIRST;
+      if (inuse)
+        {
+          g_udp_portmap[bit >> 5] |= (uint32_t)1 << (bit & 31);
+        }
+      else
+        {
+          g_udp_portmap[bit >> 5] &= ~((uint32_t)1 << (bit & 31));
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: udp_portmap_next
+ *
+ * Description:
+ *   Return the first unused port number (host byte order) after 'last' in
+ *   the ephemeral port bitmap, wrapping around at the end of the range.
+ *   The bitmap is scanned a word at a time.
+ *
+ * Returned Value:
+ *   The port number or zero if all of the ports are in use.
+ *
+ ****************************************************************************/
+
+static uint16_t udp_portmap_next(uint16_t last)
+{
+  unsigned int bit;
+  unsigned int ndx;
+  uint32_t map;
+  int i;
+
+  bit = last + 1 - UDP_PORT_FIRST;
+  if (last < UDP_PORT_FIRST || bit >= UDP_PORTMAP_NBITS)
+    {
+      bit = 0;
+    }
+
+  /* The first word is visited twice:  First for the ports after 'last',
+   * then, after wrapping around, for the ports before it.
+   */
+
+  for (i = 0; i <= UDP_PORTMAP_NWORDS; i++)
+    {
+      ndx = bit >> 5;
+
+      /* Treat the ports before the start of the search as used */
+
+      map = g_udp_portmap[ndx] | (((uint32_t)1 << (bit & 31)) - 1);
+      if (map != UINT32_MAX)
+        {
+          bit = (ndx << 5) + ffs((int)~map) - 1;
+          if (bit < UDP_PORTMAP_NBITS)
+            {
+              return bit + UDP_PORT_FIRST;
+            }
+        }
+
+      bit = (ndx + 1) << 5;
+      if (bit >= UDP_PORTMAP_NBITS)
+        {
+          bit = 0;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: udp_porthash_remove
+ *
+ * Description:
+ *   Remove a connection from the port hash table, if it is there.  This
+ *   must be done before the local port of the connection changes.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static void udp_porthash_remove(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **prev;
+  FAR struct udp_conn_s *tmp;
+  bool found = false;
+  bool shared = false;
+
+  for (prev = &g_udp_porthash[UDP_PORTHASH(conn->lport)]; *prev != NULL; )
+    {
+      tmp = *prev;
+      if (tmp == conn)
+        {
+          *prev       = conn->pnext;
+          conn->pnext = NULL;
+          found       = true;
+        }
+      else
+        {
+          if (tmp->lport == conn->lport)
+            {
+              shared = true;
+            }
+
+          prev = &tmp->pnext;
+        }
+    }
+
+  /* The port is unused when the last connection bound to it is removed */
+
+  if (found && !shared)
+    {
+      udp_portmap_set(conn->lport, false);
+    }
+}
+
+/****************************************************************************
+ * Name: udp_porthash_add
+ *
+ * Description:
+ *   Add a connection to the port hash table after its local port was
+ *   assigned.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static void udp_porthash_add(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **prev;
+
+  /* Binding twice must not link the connection twice */
+
+  udp_porthash_remove(conn);
+
+  /* Add the connection at the end of the bucket */
+
+  for (prev = &g_udp_porthash[UDP_PORTHASH(conn->lport)];
+       *prev != NULL;
+       prev = &(*prev)->pnext);
+
+  conn->pnext = NULL;
+  *prev       = conn;
+
+  udp_portmap_set(conn->lport, true);
+}
+#endif /* CONFIG_NET_UDP_CONNHASH */
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -126,13 +316,25 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
+#ifndef CONFIG_NET_UDP_CONNHASH
   int i;
+#endif
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  /* Search each connection structure bound to a port in the same bucket */
+
+  for (conn = g_udp_porthash[UDP_PORTHASH(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+#else
   /* Now search each connection structure. */
 
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
+#endif
     {
+#ifndef CONFIG_NET_UDP_CONNHASH
       conn = &g_udp_connections[i];
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -203,14 +405,23 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
 
   if (g_last_udp_port == 0)
     {
-      g_last_udp_port = clock_systime_ticks() % 32000;
+      g_last_udp_port = clock_systime_ticks() % UDP_PORT_END;
 
-      if (g_last_udp_port < 4096)
+      if (g_last_udp_port < UDP_PORT_FIRST)
         {
-          g_last_udp_port += 4096;
+          g_last_udp_port += UDP_PORT_FIRST;
         }
     }
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  /* Find the next port number that is not used by any connection in the
+   * ephemeral port bitmap.
+   */
+
+  g_last_udp_port = udp_portmap_next(g_last_udp_port);
+  DEBUGASSERT(g_last_udp_port != 0);
+#else
+
   /* Find an unused local port number.  Loop until we find a valid
    * listen port number that is not being used by any other connection.
    */
@@ -225,12 +436,13 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
 
       /* Make sure that the port number is within range */
 
-      if (g_last_udp_port >= 32000)
+      if (g_last_udp_port >= UDP_PORT_END)
         {
-          g_last_udp_port = 4096;
+          g_last_udp_port = UDP_PORT_FIRST;
         }
     }
   while (udp_find_conn(domain, u, htons(g_last_udp_port)) != NULL);
+#endif
 
   /* Initialize and return the connection structure, bind it to the
    * port number
@@ -243,11 +455,11 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
 }
 
 /****************************************************************************
- * Name: udp_ipv4_active
+ * Name: udp_ipv4_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Return true if the UDP packet in the device buffer is destined for this
+ *   connection.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -255,125 +467,210 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
-static inline FAR struct udp_conn_s *
-  udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+static inline bool udp_ipv4_match(FAR struct ipv4_hdr_s *ip,
+                                   FAR struct udp_hdr_s *udp,
+                                   FAR struct udp_conn_s *conn)
 {
 #ifdef CONFIG_NET_BROADCAST
   static const in_addr_t bcast = INADDR_BROADCAST;
 #endif
-  FAR struct ipv4_hdr_s *ip = IPv4BUF;
-  FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *   - The local port number is checked against the destination port
-       *     number in the received packet.
-       *   - If multiple network interfaces are supported, then the local
-       *     IP address is available and we will insist that the
-       *     destination IP matches the bound address (or the destination
-       *     IP address is a broadcast address). If a socket is bound to
-       *     INADDRY_ANY (laddr), then it should receive all packets
-       *     directed to the port.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *   - The remote port number is checked if the connection is bound
-       *     to a remote port.
-       *   - Finally, if the connection is bound to a remote IP address,
-       *     the source IP address of the packet is checked. Broadcast
-       *     addresses are also accepted.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVIST: SO_BROADCAST flag is currently ignored.
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *   - The local port number is checked against the destination port
+   *     number in the received packet.
+   *   - If multiple network interfaces are supported, then the local
+   *     IP address is available and we will insist that the
+   *     destination IP matches the bound address (or the destination
+   *     IP address is a broadcast address). If a socket is bound to
+   *     INADDRY_ANY (laddr), then it should receive all packets
+   *     directed to the port.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *   - The remote port number is checked if the connection is bound
+   *     to a remote port.
+   *   - Finally, if the connection is bound to a remote IP address,
+   *     the source IP address of the packet is checked. Broadcast
+   *     addresses are also accepted.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVIST: SO_BROADCAST flag is currently ignored.
+   */
+
+  /* Check that there is a local port number and this is matches
+   * the port number in the destination address.
+   */
+
+  if (conn->lport != 0 && udp->destport == conn->lport &&
+
+      /* Local port accepts any address on this port or there
+       * is an exact match in destipaddr and the bound local
+       * address.  This catches the receipt of a broadcast when
+       * the socket is bound to INADDR_ANY.
        */
 
-      /* Check that there is a local port number and this is matches
-       * the port number in the destination address.
+      (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
+       net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+    {
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
        */
 
-      if (conn->lport != 0 && udp->destport == conn->lport &&
+      if (_UDP_ISCONNECTMODE(conn->flags))
+        {
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
+           */
+
+          if ((conn->rport == 0 || udp->srcport == conn->rport) &&
 
-          /* Local port accepts any address on this port or there
-           * is an exact match in destipaddr and the bound local
-           * address.  This catches the receipt of a broadcast when
-           * the socket is bound to INADDR_ANY.
+          /* If (1) not connected to a remote address, or (2) a
+           * broadcast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
            */
 
-          (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
-           net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+              (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
+#ifdef CONFIG_NET_BROADCAST
+               net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
+#endif
+               net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
+            {
+              /* Matching connection found */
+
+              return true;
+            }
+        }
+      else
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* This UDP socket is not connected.  We need to match only
+           * the destination address with the bound socket address.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
+          return true;
+        }
+    }
 
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+  return false;
+}
 
-              /* If (1) not connected to a remote address, or (2) a
-               * broadcast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+#ifdef CONFIG_NET_UDP_CONNHASH
+/****************************************************************************
+ * Name: udp_ipv4_rank
+ *
+ * Description:
+ *   Return the specificity of a matching connection:  One for each of a
+ *   bound local address, a connected remote port and a connected remote
+ *   address.
+ *
+ ****************************************************************************/
 
-                  (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
-#ifdef CONFIG_NET_BROADCAST
-                   net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
+static inline int udp_ipv4_rank(FAR struct udp_conn_s *conn)
+{
+  int rank = 0;
+
+  if (!net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY))
+    {
+      rank++;
+    }
+
+  if (_UDP_ISCONNECTMODE(conn->flags))
+    {
+      if (conn->rport != 0)
+        {
+          rank++;
+        }
+
+      if (!net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY))
+        {
+          rank++;
+        }
+    }
+
+  return rank;
+}
 #endif
-                   net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
-                {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
 
-                  break;
-                }
-            }
-          else
-            {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
+/****************************************************************************
+ * Name: udp_ipv4_active
+ *
+ * Description:
+ *   Find a connection structure that is the appropriate connection to be
+ *   used within the provided UDP header
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR struct udp_conn_s *
+  udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+{
+  FAR struct ipv4_hdr_s *ip = IPv4BUF;
+  FAR struct udp_conn_s *conn;
+#ifdef CONFIG_NET_UDP_CONNHASH
+  FAR struct udp_conn_s *best = NULL;
+  int bestrank = -1;
+  int rank;
+
+  /* Only the connections bound to the destination port can match and
+   * those are all in the same bucket of the port hash table.  If several
+   * connections match, the most specific one receives the packet.  Of
+   * equally specific connections, the one bound first wins.
+   */
 
-              break;
+  for (conn = g_udp_porthash[UDP_PORTHASH(udp->destport)];
+       conn != NULL;
+       conn = conn->pnext)
+    {
+      if (udp_ipv4_match(ip, udp, conn))
+        {
+          rank = udp_ipv4_rank(conn);
+          if (rank > bestrank)
+            {
+              best     = conn;
+              bestrank = rank;
             }
         }
+    }
+
+  return best;
+#else
+  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  while (conn != NULL)
+    {
+      if (udp_ipv4_match(ip, udp, conn))
+        {
+          break;
+        }
 
       /* Look at the next active connection */
 
@@ -381,15 +678,16 @@ static inline FAR struct udp_conn_s *
     }
 
   return conn;
+#endif
 }
 #endif /* CONFIG_NET_IPv4 */
 
 /****************************************************************************
- * Name: udp_ipv6_active
+ * Name: udp_ipv6_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Return true if the UDP packet in the device buffer is destined for this
+ *   connection.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -397,122 +695,206 @@ static inline FAR struct udp_conn_s *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv6
-static inline FAR struct udp_conn_s *
-  udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+static inline bool udp_ipv6_match(FAR struct ipv6_hdr_s *ip,
+                                   FAR struct udp_hdr_s *udp,
+                                   FAR struct udp_conn_s *conn)
 {
-  FAR struct ipv6_hdr_s *ip = IPv6BUF;
-  FAR struct udp_conn_s *conn;
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *    - The local port number is checked against the destination port
+   *      number in the received packet.
+   *    - If multiple network interfaces are supported, then the local
+   *      IP address is available and we will insist that the
+   *      destination IP matches the bound address. If a socket is bound
+   *      to INADDR6_ANY (laddr), then it should receive all packets
+   *      directed to the port. REVISIT: Should also depend on
+   *      SO_BROADCAST.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *    - The remote port number is checked if the connection is bound
+   *      to a remote port.
+   *    - Finally, if the connection is bound to a remote IP address,
+   *      the source IP address of the packet is checked.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVIST: SO_BROADCAST flag is currently ignored.
+   */
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn != NULL)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *    - The local port number is checked against the destination port
-       *      number in the received packet.
-       *    - If multiple network interfaces are supported, then the local
-       *      IP address is available and we will insist that the
-       *      destination IP matches the bound address. If a socket is bound
-       *      to INADDR6_ANY (laddr), then it should receive all packets
-       *      directed to the port. REVISIT: Should also depend on
-       *      SO_BROADCAST.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *    - The remote port number is checked if the connection is bound
-       *      to a remote port.
-       *    - Finally, if the connection is bound to a remote IP address,
-       *      the source IP address of the packet is checked.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVIST: SO_BROADCAST flag is currently ignored.
+  /* Check that there is a local port number and this is matches
+   * the port number in the destination address.
+   */
+
+  if ((conn->lport != 0 && udp->destport == conn->lport &&
+
+      /* Check if the local port accepts any address on this port or
+       * that there is an exact match between the destipaddr and the
+       * bound local address.  This catches the case of the all nodes
+       * multicast when the socket is bound to the IPv6 unspecified
+       * address.
        */
 
-      /* Check that there is a local port number and this is matches
-       * the port number in the destination address.
+      (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
+       net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+    {
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
        */
 
-      if ((conn->lport != 0 && udp->destport == conn->lport &&
+      if (_UDP_ISCONNECTMODE(conn->flags))
+        {
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
+           */
 
-          /* Check if the local port accepts any address on this port or
-           * that there is an exact match between the destipaddr and the
-           * bound local address.  This catches the case of the all nodes
-           * multicast when the socket is bound to the IPv6 unspecified
-           * address.
+          if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+
+          /* If (1) not connected to a remote address, or (2) a all-
+           * nodes multicast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
            */
 
-          (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
-           net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+              (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
+#ifdef CONFIG_NET_BROADCAST
+               net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
+#endif
+               net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
+            {
+              /* Matching connection found */
+
+              return true;
+            }
+        }
+      else
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* This UDP socket is not connected.  We need to match only
+           * the destination address with the bound socket address.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#ifdef CONFIG_NET_UDP_CONNHASH
+/****************************************************************************
+ * Name: udp_ipv6_rank
+ *
+ * Description:
+ *   Return the specificity of a matching connection:  One for each of a
+ *   bound local address, a connected remote port and a connected remote
+ *   address.
+ *
+ ****************************************************************************/
 
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+static inline int udp_ipv6_rank(FAR struct udp_conn_s *conn)
+{
+  int rank = 0;
 
-              /* If (1) not connected to a remote address, or (2) a all-
-               * nodes multicast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+  if (!net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr))
+    {
+      rank++;
+    }
 
-                  (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
-#ifdef CONFIG_NET_BROADCAST
-                   net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
+  if (_UDP_ISCONNECTMODE(conn->flags))
+    {
+      if (conn->rport != 0)
+        {
+          rank++;
+        }
+
+      if (!net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr))
+        {
+          rank++;
+        }
+    }
+
+  return rank;
+}
 #endif
-                   net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
-                {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
 
-                  break;
-                }
-            }
-          else
-            {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
+/****************************************************************************
+ * Name: udp_ipv6_active
+ *
+ * Description:
+ *   Find a connection structure that is the appropriate connection to be
+ *   used within the provided UDP header
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR struct udp_conn_s *
+  udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+{
+  FAR struct ipv6_hdr_s *ip = IPv6BUF;
+  FAR struct udp_conn_s *conn;
+#ifdef CONFIG_NET_UDP_CONNHASH
+  FAR struct udp_conn_s *best = NULL;
+  int bestrank = -1;
+  int rank;
+
+  /* Only the connections bound to the destination port can match and
+   * those are all in the same bucket of the port hash table.  If several
+   * connections match, the most specific one receives the packet.  Of
+   * equally specific connections, the one bound first wins.
+   */
 
-              break;
+  for (conn = g_udp_porthash[UDP_PORTHASH(udp->destport)];
+       conn != NULL;
+       conn = conn->pnext)
+    {
+      if (udp_ipv6_match(ip, udp, conn))
+        {
+          rank = udp_ipv6_rank(conn);
+          if (rank > bestrank)
+            {
+              best     = conn;
+              bestrank = rank;
             }
         }
+    }
+
+  return best;
+#else
+  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  while (conn != NULL)
+    {
+      if (udp_ipv6_match(ip, udp, conn))
+        {
+          break;
+        }
 
       /* Look at the next active connection */
 
@@ -520,6 +902,7 @@ static inline FAR struct udp_conn_s *
     }
 
   return conn;
+#endif
 }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -620,6 +1003,11 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
+#ifdef CONFIG_NET_UDP_CONNHASH
+  net_lock();
+  udp_porthash_remove(conn);
+  net_unlock();
+#endif
   conn->lport = 0;
 
   /* Remove the connection from the active list */
@@ -769,8 +1157,16 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+      net_lock();
+      udp_porthash_remove(conn);
+#endif
       conn->lport = htons(udp_select_port(conn->domain, &conn->u));
       ret         = OK;
+#ifdef CONFIG_NET_UDP_CONNHASH
+      udp_porthash_add(conn);
+      net_unlock();
+#endif
     }
   else
     {
@@ -786,8 +1182,14 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+          udp_porthash_remove(conn);
+#endif
           conn->lport = portno;
           ret         = OK;
+#ifdef CONFIG_NET_UDP_CONNHASH
+          udp_porthash_add(conn);
+#endif
         }
       else
         {
@@ -839,7 +1241,14 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+      net_lock();
+      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_porthash_add(conn);
+      net_unlock();
+#else
       conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+#endif
     }
 
   /* Is there a remote port (rport)? */
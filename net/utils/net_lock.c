@@ -39,6 +39,9 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 #include <unistd.h>
 #include <sched.h>
 #include <assert.h>
@@ -46,6 +49,7 @@
 #include <debug.h>
 #include <time.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/irq.h>
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
@@ -60,6 +64,22 @@
 
 #define NO_HOLDER (pid_t)-1
 
+/* The call site of net_lock() is used to tell the paths that take the
+ * network lock apart.
+ */
+
+#if defined(CONFIG_NET_LOCK_STATS) && defined(__GNUC__)
+#  define NET_LOCK_CALLER() __builtin_return_address(0)
+#else
+#  define NET_LOCK_CALLER() NULL
+#endif
+
+#ifndef CONFIG_NET_LOCK_STATS
+#  define net_lockstat_acquired(s,c)
+#  define net_lockstat_resumed(s)
+#  define net_lockstat_released()
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -68,10 +88,126 @@ static sem_t        g_netlock;
 static pid_t        g_holder = NO_HOLDER;
 static unsigned int g_count  = 0;
 
+#ifdef CONFIG_NET_LOCK_STATS
+/* Lock statistics.  These are modified only by the holder of the network
+ * lock.  The last entry accumulates the call sites that do not fit in the
+ * table.
+ */
+
+static struct net_lockstat_s g_lockstat[CONFIG_NET_LOCK_STATS_NSITES + 1];
+static FAR void *g_lockstat_site;   /* Call site of the current holder */
+static uint32_t  g_lockstat_start;  /* Time the lock was taken */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_lockstat_elapsed
+ *
+ * Description:
+ *   Return the time in microseconds since 'start', a value returned by
+ *   up_critmon_gettime().  The system time has only tick resolution, which
+ *   is too coarse for most hold times, so the high resolution timer of the
+ *   critical section monitor is used instead.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+static uint32_t net_lockstat_elapsed(uint32_t start)
+{
+  struct timespec ts;
+
+  up_critmon_convert(up_critmon_gettime() - start, &ts);
+  return (uint32_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: net_lockstat_acquired
+ *
+ * Description:
+ *   Account an acquisition of the network lock to its call site and start
+ *   the hold time measurement.  Called after the lock has been taken.
+ *
+ ****************************************************************************/
+
+static void net_lockstat_acquired(FAR void *site, bool contended)
+{
+  FAR struct net_lockstat_s *stat;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_LOCK_STATS_NSITES; i++)
+    {
+      stat = &g_lockstat[i];
+      if (stat->site == site || stat->acquired == 0)
+        {
+          break;
+        }
+    }
+
+  stat           = &g_lockstat[i];
+  stat->site     = i < CONFIG_NET_LOCK_STATS_NSITES ? site : NULL;
+  stat->acquired++;
+  if (contended)
+    {
+      stat->contended++;
+    }
+
+  g_lockstat_site  = site;
+  g_lockstat_start = up_critmon_gettime();
+}
+
+/****************************************************************************
+ * Name: net_lockstat_resumed
+ *
+ * Description:
+ *   Restart the hold time measurement when the lock is restored after a
+ *   wait.  This is not counted as a new acquisition.
+ *
+ ****************************************************************************/
+
+static void net_lockstat_resumed(FAR void *site)
+{
+  g_lockstat_site  = site;
+  g_lockstat_start = up_critmon_gettime();
+}
+
+/****************************************************************************
+ * Name: net_lockstat_released
+ *
+ * Description:
+ *   Account the hold time to the call site that took the lock.  Called
+ *   before the lock is released.
+ *
+ ****************************************************************************/
+
+static void net_lockstat_released(void)
+{
+  FAR struct net_lockstat_s *stat;
+  uint32_t held;
+  int i;
+
+  held = net_lockstat_elapsed(g_lockstat_start);
+
+  for (i = 0; i < CONFIG_NET_LOCK_STATS_NSITES; i++)
+    {
+      stat = &g_lockstat[i];
+      if (stat->site == g_lockstat_site || stat->acquired == 0)
+        {
+          break;
+        }
+    }
+
+  stat        = &g_lockstat[i];
+  stat->held += held;
+  if (held > stat->maxheld)
+    {
+      stat->maxheld = held;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: _net_takesem
  *
@@ -97,10 +233,19 @@ _net_timedwait(sem_t *sem, bool interruptible, unsigned int timeout)
   irqstate_t   flags;
   int          blresult;
   int          ret;
+#ifdef CONFIG_NET_LOCK_STATS
+  FAR void    *site;
+#endif
 
   flags = enter_critical_section(); /* No interrupts */
   sched_lock();                     /* No context switches */
 
+#ifdef CONFIG_NET_LOCK_STATS
+  /* The hold time after the wait is accounted to the original caller */
+
+  site = g_lockstat_site;
+#endif
+
   /* Release the network lock, remembering my count.  net_breaklock will
    * return a negated value if the caller does not hold the network lock.
    */
@@ -153,6 +298,9 @@ _net_timedwait(sem_t *sem, bool interruptible, unsigned int timeout)
   if (blresult >= 0)
     {
       net_restorelock(count);
+#ifdef CONFIG_NET_LOCK_STATS
+      g_lockstat_site = site;
+#endif
     }
 
   sched_unlock();
@@ -198,6 +346,9 @@ int net_lock(void)
   irqstate_t flags = enter_critical_section();
 #endif
   pid_t me = getpid();
+#ifdef CONFIG_NET_LOCK_STATS
+  bool contended;
+#endif
   int ret = OK;
 
   /* Does this thread already hold the semaphore? */
@@ -212,13 +363,25 @@ int net_lock(void)
     {
       /* No.. take the semaphore (perhaps waiting) */
 
+#ifdef CONFIG_NET_LOCK_STATS
+      /* Try first to find out whether the caller has to wait */
+
+      contended = (nxsem_trywait(&g_netlock) < 0);
+      if (contended)
+        {
+          ret = _net_takesem();
+        }
+#else
       ret = _net_takesem();
+#endif
+
       if (ret >= 0)
         {
           /* Now this thread holds the semaphore */
 
           g_holder = me;
           g_count  = 1;
+          net_lockstat_acquired(NET_LOCK_CALLER(), contended);
         }
     }
 
@@ -270,6 +433,7 @@ int net_trylock(void)
 
           g_holder = me;
           g_count  = 1;
+          net_lockstat_acquired(NET_LOCK_CALLER(), false);
         }
     }
 
@@ -306,6 +470,7 @@ void net_unlock(void)
     {
       /* We no longer hold the semaphore */
 
+      net_lockstat_released();
       g_holder = NO_HOLDER;
       g_count  = 0;
       nxsem_post(&g_netlock);
@@ -348,6 +513,7 @@ int net_breaklock(FAR unsigned int *count)
 
       /* Release the network lock  */
 
+      net_lockstat_released();
       g_holder = NO_HOLDER;
       g_count  = 0;
 
@@ -385,6 +551,7 @@ int net_restorelock(unsigned int count)
     {
       g_holder = me;
       g_count  = count;
+      net_lockstat_resumed(NET_LOCK_CALLER());
     }
 
   return ret;
@@ -517,6 +684,9 @@ FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e consumerid)
       irqstate_t flags;
       unsigned int count;
       int blresult;
+#ifdef CONFIG_NET_LOCK_STATS
+      FAR void *site = g_lockstat_site;
+#endif
 
       /* There are no buffers available now.  We will have to wait for one to
        * become available. But let's not do that with the network locked.
@@ -528,6 +698,9 @@ FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e consumerid)
       if (blresult >= 0)
         {
           net_restorelock(count);
+#ifdef CONFIG_NET_LOCK_STATS
+          g_lockstat_site = site;
+#endif
         }
 
       leave_critical_section(flags);
@@ -536,3 +709,44 @@ FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e consumerid)
   return iob;
 }
 #endif
+
+/****************************************************************************
+ * Name: net_lockstat
+ *
+ * Description:
+ *   Return the statistics of one call site of net_lock().
+ *
+ * Input Parameters:
+ *   index - The index of the call site.  The last index,
+ *           CONFIG_NET_LOCK_STATS_NSITES, returns the sum of the call sites
+ *           that did not fit in the table.
+ *   stat  - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if there is no
+ *   such call site.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+int net_lockstat(int index, FAR struct net_lockstat_s *stat)
+{
+  irqstate_t flags;
+
+  if (index < 0 || index > CONFIG_NET_LOCK_STATS_NSITES ||
+      g_lockstat[index].acquired == 0)
+    {
+      return -ENOENT;
+    }
+
+  /* The statistics are updated by the lock holder.  Copy them in a
+   * critical section so that one entry is at least consistent on a
+   * single CPU.
+   */
+
+  flags = enter_critical_section();
+  memcpy(stat, &g_lockstat[index], sizeof(struct net_lockstat_s));
+  leave_critical_section(flags);
+  return OK;
+}
+#endif
@@ -57,6 +57,22 @@ enum tv2ds_remainder_e
   TV2DS_CEIL       /* Force to next larger full decisecond */
 };
 
+#ifdef CONFIG_NET_LOCK_STATS
+/* Statistics of one call site of net_lock().  The hold time runs from the
+ * outermost net_lock() to the final net_unlock() and is interrupted while
+ * the lock is given up by net_lockedwait() and friends.
+ */
+
+struct net_lockstat_s
+{
+  FAR void *site;                /* Return address of the net_lock() call */
+  uint32_t acquired;             /* Number of times the lock was taken */
+  uint32_t contended;            /* Number of times the caller had to wait */
+  uint32_t maxheld;              /* Longest hold time (usec) */
+  uint64_t held;                 /* Total hold time (usec) */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -111,6 +127,21 @@ int net_breaklock(FAR unsigned int *count);
 
 int net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_lockstat
+ *
+ * Description:
+ *   Return the statistics of one call site of net_lock().  The last index,
+ *   CONFIG_NET_LOCK_STATS_NSITES, returns the sum of the call sites that
+ *   did not fit in the table.  -ENOENT is returned if the call site is not
+ *   in use.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+int net_lockstat(int index, FAR struct net_lockstat_s *stat);
+#endif
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
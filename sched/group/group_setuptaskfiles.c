@@ -74,6 +74,8 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
   /* The parent task is the one at the head of the ready-to-run list */
 
   FAR struct tcb_s *rtcb = this_task();
+  FAR struct filelist *plist;
+  FAR struct filelist *clist;
   FAR struct file *parent;
   FAR struct file *child;
   int i;
@@ -88,8 +90,8 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
 
   /* Get pointers to the parent and child task file lists */
 
-  parent = rtcb->group->tg_filelist.fl_files;
-  child  = tcb->cmn.group->tg_filelist.fl_files;
+  plist = &rtcb->group->tg_filelist;
+  clist = &tcb->cmn.group->tg_filelist;
 
   /* Check each file in the parent file list */
 
@@ -100,12 +102,29 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
        * i-node structure.
        */
 
-      if (parent[i].f_inode &&
-          (parent[i].f_oflags & O_CLOEXEC) == 0)
+      parent = files_fget(plist, i);
+      if (parent == NULL)
         {
-          /* Yes... duplicate it for the child */
+          /* Skip the rest of the unallocated chunk */
+
+          i = (i / FILELIST_CHUNK + 1) * FILELIST_CHUNK - 1;
+          continue;
+        }
 
-          file_dup2(&parent[i], &child[i]);
+      if (parent->f_inode &&
+          (parent->f_oflags & O_CLOEXEC) == 0 &&
+          files_extend(clist, i) >= 0)
+        {
+          /* Yes... duplicate it for the child.  The child is not running
+           * yet, so its list can be updated without the list semaphore.
+           */
+
+          child = files_fget(clist, i);
+          if (file_dup2(parent, child) >= 0)
+            {
+              clist->fl_used[i / FILELIST_CHUNK] |=
+                (uint32_t)1 << (i % FILELIST_CHUNK);
+            }
         }
     }
 }
@@ -93,6 +93,12 @@ void nx_idle_trampoline(void)
 
   for (; ; )
     {
+#ifdef CONFIG_SMP_WORKSTEALING
+      /* Pick up any runnable work that was left in g_readytorun */
+
+      nxsched_idle_steal();
+
+#endif
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -523,6 +523,7 @@ void nx_start(void)
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+      nxsched_prioindex_add(tasklist, &g_idletcb[cpu].cmn);
 
       /* Mark the idle task as the running task */
 
@@ -827,6 +828,12 @@ void nx_start(void)
   sinfo("CPU0: Beginning Idle Loop\n");
   for (; ; )
     {
+#ifdef CONFIG_SMP_WORKSTEALING
+      /* Pick up any runnable work that was left in g_readytorun */
+
+      nxsched_idle_steal();
+
+#endif
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -171,6 +171,26 @@ void weak_function irq_initialize(void);
 
 int irq_unexpected_isr(int irq, FAR void *context, FAR void *arg);
 
+/****************************************************************************
+ * Name: enter_critical_section_class
+ *
+ * Description:
+ *   Same as enter_critical_section(), but any wait for the CPU IRQ lock is
+ *   also accounted to the given lock class.
+ *
+ * Input Parameters:
+ *   lockclass - One of enum irqlock_class_e
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t enter_critical_section_class(int lockclass);
+#endif
+
 /****************************************************************************
  * Name:  irq_cpu_locked
  *
@@ -95,7 +95,11 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
  *   interrupts disabled.
  *
  * Input Parameters:
- *   cpu - The index of CPU that is trying to enter the critical section.
+ *   cpu       - The index of CPU that is trying to enter the critical
+ *               section.
+ *   lockclass - The lock class on whose behalf the critical section is
+ *               entered.  Any wait is accounted to this class as well as
+ *               to IRQLOCK_GLOBAL.
  *
  * Returned Value:
  *   True:  The g_cpu_irqlock spinlock has been taken.
@@ -105,11 +109,18 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
  ****************************************************************************/
 
 #ifdef CONFIG_SMP
-static inline bool irq_waitlock(int cpu)
+static inline bool irq_waitlock(int cpu, int lockclass)
 {
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = current_task(cpu);
+#endif
+#ifdef CONFIG_SPINLOCK_STATS
+  FAR struct irqlock_stat_s *stat = &g_irqlock_stat[cpu][IRQLOCK_GLOBAL];
+  FAR struct irqlock_stat_s *cstat = &g_irqlock_stat[cpu][lockclass];
+  bool contended = false;
+#endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we are waiting for a spinlock */
 
   sched_note_spinlock(tcb, &g_cpu_irqlock);
@@ -121,6 +132,31 @@ static inline bool irq_waitlock(int cpu)
 
   while (spin_trylock_wo_note(&g_cpu_irqlock) == SP_LOCKED)
     {
+#ifdef CONFIG_SPINLOCK_STATS
+      /* Account for the time spent spinning on the global lock */
+
+      /* The wait is also accounted to the lock class that fell back to
+       * the global lock, if any.
+       */
+
+      if (!contended)
+        {
+          stat->contended++;
+          if (cstat != stat)
+            {
+              cstat->contended++;
+            }
+
+          contended = true;
+        }
+
+      stat->spins++;
+      if (cstat != stat)
+        {
+          cstat->spins++;
+        }
+#endif
+
       /* Is a pause request pending? */
 
       if (up_cpu_pausereq(cpu))
@@ -141,6 +177,10 @@ static inline bool irq_waitlock(int cpu)
 
   /* We have g_cpu_irqlock! */
 
+#ifdef CONFIG_SPINLOCK_STATS
+  stat->acquired++;
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
@@ -156,17 +196,17 @@ static inline bool irq_waitlock(int cpu)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: enter_critical_section
+ * Name: enter_critical_section_class
  *
  * Description:
- *   Take the CPU IRQ lock and disable interrupts on all CPUs.  A thread-
- *   specific counter is increment to indicate that the thread has IRQs
- *   disabled and to support nested calls to enter_critical_section().
+ *   Same as enter_critical_section(), but any wait for the CPU IRQ lock is
+ *   also accounted to the given lock class.  This is used by the lock
+ *   classes that still fall back to the global IRQ lock.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_SMP
-irqstate_t enter_critical_section(void)
+irqstate_t enter_critical_section_class(int lockclass)
 {
   FAR struct tcb_s *rtcb;
   irqstate_t ret;
@@ -265,7 +305,7 @@ try_again:
                    * no longer blocked by the critical section).
                    */
 
-                  if (!irq_waitlock(cpu))
+                  if (!irq_waitlock(cpu, lockclass))
                     {
                       /* We are in a deadlock condition due to a pending
                        * pause request interrupt request.  Break the
@@ -327,7 +367,7 @@ try_again:
 
               DEBUGASSERT((g_cpu_irqset & (1 << cpu)) == 0);
 
-              if (!irq_waitlock(cpu))
+              if (!irq_waitlock(cpu, lockclass))
                 {
                   /* We are in a deadlock condition due to a pending pause
                    * request interrupt.  Re-enable interrupts on this CPU
@@ -375,6 +415,21 @@ try_again:
   return ret;
 }
 
+/****************************************************************************
+ * Name: enter_critical_section
+ *
+ * Description:
+ *   Take the CPU IRQ lock and disable interrupts on all CPUs.  A thread-
+ *   specific counter is increment to indicate that the thread has IRQs
+ *   disabled and to support nested calls to enter_critical_section().
+ *
+ ****************************************************************************/
+
+irqstate_t enter_critical_section(void)
+{
+  return enter_critical_section_class(IRQLOCK_GLOBAL);
+}
+
 #else
 
 irqstate_t enter_critical_section(void)
@@ -0,0 +1,188 @@
+/****************************************************************************
+ * sched/irq/irq_lockclass.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+#include "irq/irq.h"
+
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_SCOPEDLOCKS
+/* The spinlock of each lock class */
+
+static volatile spinlock_t g_irqlock_class[IRQLOCK_NCLASSES] SP_SECTION;
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_SCOPEDLOCKS
+/* The lock classes that have been converted to scoped locks.  A subsystem
+ * can be converted only if its critical sections protect nothing but its
+ * own data, never suspend the caller and never call
+ * enter_critical_section().  The other classes still use the global IRQ
+ * lock.
+ */
+
+const bool g_irqlock_scoped[IRQLOCK_NCLASSES] =
+{
+  false,                        /* IRQLOCK_GLOBAL */
+  false,                        /* IRQLOCK_WDOG: Expiration runs callbacks */
+  false,                        /* IRQLOCK_SEMAPHORE: Uses task lists */
+  true,                         /* IRQLOCK_MQUEUE */
+  false                         /* IRQLOCK_WQUEUE: Worker waits in lock */
+};
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+/* Per-CPU lock statistics for each lock class */
+
+struct irqlock_stat_s g_irqlock_stat[CONFIG_SMP_NCPUS][IRQLOCK_NCLASSES];
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_lock_irqsave_class
+ *
+ * Description:
+ *   If SMP_SCOPEDLOCKS is enabled and the lock class has been converted to
+ *   a scoped lock, disable local interrupts and take the spinlock of the
+ *   lock class.  Otherwise, enter the global critical section.
+ *
+ * Input Parameters:
+ *   lockclass - One of enum irqlock_class_e
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_class();
+ *
+ ****************************************************************************/
+
+irqstate_t spin_lock_irqsave_class(int lockclass)
+{
+  irqstate_t flags;
+#ifdef CONFIG_SPINLOCK_STATS
+  FAR struct irqlock_stat_s *stat;
+#endif
+
+  DEBUGASSERT(lockclass > IRQLOCK_GLOBAL && lockclass < IRQLOCK_NCLASSES);
+
+#ifdef CONFIG_SMP_SCOPEDLOCKS
+  if (g_irqlock_scoped[lockclass])
+    {
+      /* Disable local interrupts BEFORE taking the spinlock so that an
+       * interrupt handler on this CPU cannot spin on the lock that we
+       * hold.
+       */
+
+      flags = up_irq_save();
+
+#ifdef CONFIG_SPINLOCK_STATS
+      stat = &g_irqlock_stat[this_cpu()][lockclass];
+      if (spin_trylock_wo_note(&g_irqlock_class[lockclass]) == SP_LOCKED)
+        {
+          stat->contended++;
+          do
+            {
+              stat->spins++;
+            }
+          while (spin_trylock_wo_note(&g_irqlock_class[lockclass]) ==
+                 SP_LOCKED);
+        }
+
+      stat->acquired++;
+#else
+      spin_lock(&g_irqlock_class[lockclass]);
+#endif
+      return flags;
+    }
+#endif
+
+  /* This subsystem still depends on the global IRQ lock.  Any contention
+   * is accounted both to IRQLOCK_GLOBAL and to the lock class.
+   */
+
+  flags = enter_critical_section_class(lockclass);
+
+#ifdef CONFIG_SPINLOCK_STATS
+  stat = &g_irqlock_stat[this_cpu()][lockclass];
+  stat->acquired++;
+#endif
+
+  return flags;
+}
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore_class
+ *
+ * Description:
+ *   Release the lock taken by spin_lock_irqsave_class() and restore the
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   lockclass - The lock class passed to spin_lock_irqsave_class()
+ *   flags     - The architecture-specific value that represents the state
+ *               of the interrupts prior to the call to
+ *               spin_lock_irqsave_class();
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spin_unlock_irqrestore_class(int lockclass, irqstate_t flags)
+{
+  DEBUGASSERT(lockclass > IRQLOCK_GLOBAL && lockclass < IRQLOCK_NCLASSES);
+
+#ifdef CONFIG_SMP_SCOPEDLOCKS
+  if (g_irqlock_scoped[lockclass])
+    {
+      spin_unlock(&g_irqlock_class[lockclass]);
+      up_irq_restore(flags);
+    }
+  else
+#endif
+    {
+      leave_critical_section(flags);
+    }
+}
+
+#endif /* CONFIG_SMP */
@@ -66,9 +66,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(IRQLOCK_MQUEUE);
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(IRQLOCK_MQUEUE, flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -81,9 +81,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(IRQLOCK_MQUEUE);
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(IRQLOCK_MQUEUE, flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
@@ -133,8 +133,11 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
   if (up_interrupt_context())
     {
-      /* Try the general free list */
+      /* Try the general free list.  The free lists may also be accessed
+       * from other CPUs.
+       */
 
+      flags = spin_lock_irqsave_class(IRQLOCK_MQUEUE);
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
       if (mqmsg == NULL)
         {
@@ -142,6 +145,8 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
           mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
         }
+
+      spin_unlock_irqrestore_class(IRQLOCK_MQUEUE, flags);
     }
 
   /* We were not called from an interrupt handler. */
@@ -152,9 +157,9 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
        * Disable interrupts -- we might be called from an interrupt handler.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(IRQLOCK_MQUEUE);
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(IRQLOCK_MQUEUE, flags);
 
       /* If we cannot a message from the free list, then we will have to
        * allocate one.
@@ -133,6 +133,23 @@ struct tasklist_s
   uint8_t attr;                   /* List attribute flags */
 };
 
+#ifdef CONFIG_SCHED_PRIOINDEX
+/* This structure indexes a prioritized task list by priority.  For each
+ * priority present in the list, it holds the last TCB of that priority
+ * (the TCBs of one priority form a FIFO within the list).  The bitmap has
+ * one bit set for each priority that is present in the list.  With this
+ * index, a TCB can be inserted into the list without walking it.
+ */
+
+#define PRIOINDEX_NWORDS ((SCHED_PRIORITY_MAX + 32) >> 5)
+
+struct prioindex_s
+{
+  uint32_t map[PRIOINDEX_NWORDS];                 /* Priorities present */
+  FAR struct tcb_s *tail[SCHED_PRIORITY_MAX + 1]; /* Last TCB per priority */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -366,6 +383,19 @@ void nxsched_add_blocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 
+/* Priority index of the ready-to-run task lists */
+
+#ifdef CONFIG_SCHED_PRIOINDEX
+bool nxsched_prioindex_find(FAR dq_queue_t *list, uint8_t sched_priority,
+                            FAR struct tcb_s **tcb);
+void nxsched_prioindex_add(FAR dq_queue_t *list, FAR struct tcb_s *tcb);
+void nxsched_prioindex_remove(FAR dq_queue_t *list, FAR struct tcb_s *tcb);
+#else
+#  define nxsched_prioindex_find(list,prio,tcb) (false)
+#  define nxsched_prioindex_add(list,tcb)
+#  define nxsched_prioindex_remove(list,tcb)
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -420,6 +450,10 @@ int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
 irqstate_t nxsched_lock_tasklist(void);
 void nxsched_unlock_tasklist(irqstate_t lock);
 
+#  ifdef CONFIG_SMP_WORKSTEALING
+void nxsched_idle_steal(void);
+#  endif
+
 #  define nxsched_islocked_global() spin_islocked(&g_cpu_schedlock)
 #  define nxsched_islocked_tcb(tcb) nxsched_islocked_global()
 
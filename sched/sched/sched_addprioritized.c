@@ -89,11 +89,21 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
+   * If the list is indexed by priority, then the TCB goes right after the
+   * last TCB of the same or the next higher priority and no search is
+   * needed.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
-       next = next->flink);
+  if (nxsched_prioindex_find(list, sched_priority, &prev))
+    {
+      next = prev ? prev->flink : (FAR struct tcb_s *)list->head;
+    }
+  else
+    {
+      for (next = (FAR struct tcb_s *)list->head;
+           (next && sched_priority <= next->sched_priority);
+           next = next->flink);
+    }
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
@@ -151,5 +161,8 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+  /* The new TCB is now the last TCB of its priority */
+
+  nxsched_prioindex_add(list, tcb);
   return ret;
 }
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * sched/sched/sched_idlesteal.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SMP_WORKSTEALING)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_idle_steal
+ *
+ * Description:
+ *   Called from the IDLE loop of each CPU.  If the g_readytorun list holds
+ *   a task that is permitted to run on this CPU, then that task is
+ *   re-submitted to the scheduler.  Since this CPU is idle, the task will
+ *   be started on this CPU or on some other idle CPU in its affinity mask.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called only from the IDLE task of the current CPU.
+ *
+ ****************************************************************************/
+
+void nxsched_idle_steal(void)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int me;
+
+  /* Avoid taking the IRQ lock on every pass through the IDLE loop when no
+   * task is waiting.  Only the list head is read without the lock; the
+   * TCBs in the list may be removed and freed by another CPU at any time,
+   * so they are only visited under the lock.  A stale head is harmless:
+   * the list is checked again under the lock or on the next pass.
+   */
+
+  if (g_readytorun.head == NULL)
+    {
+      return;
+    }
+
+  me    = this_cpu();
+  flags = enter_critical_section();
+
+  /* Nothing can be started while pre-emption is disabled.  The pending
+   * task list will be merged when the scheduler is unlocked.
+   */
+
+  if (!nxsched_islocked_global())
+    {
+      /* Find the highest priority task that can run on this CPU */
+
+      for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+           tcb != NULL && !CPU_ISSET(me, &tcb->affinity);
+           tcb = (FAR struct tcb_s *)tcb->flink);
+
+      /* Only a task with a priority above the IDLE task of this CPU needs
+       * to be started here.
+       */
+
+      if (tcb != NULL &&
+          tcb->sched_priority > current_task(me)->sched_priority)
+        {
+          DEBUGASSERT(tcb->task_state == TSTATE_TASK_READYTORUN);
+
+          /* Remove the task from g_readytorun and add it back.  The task
+           * will be assigned to the CPU with the lowest priority running
+           * task, which is this CPU or another idle CPU.  The context
+           * switch, if any, is performed by up_reprioritize_rtr().
+           */
+
+          up_reprioritize_rtr(tcb, tcb->sched_priority);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SMP && CONFIG_SMP_WORKSTEALING */
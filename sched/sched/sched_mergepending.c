@@ -72,11 +72,39 @@
 bool nxsched_merge_pending(void)
 {
   FAR struct tcb_s *ptcb;
+#ifndef CONFIG_SCHED_PRIOINDEX
   FAR struct tcb_s *pnext;
-  FAR struct tcb_s *rtcb;
   FAR struct tcb_s *rprev;
+#endif
+  FAR struct tcb_s *rtcb;
   bool ret = false;
 
+#ifdef CONFIG_SCHED_PRIOINDEX
+  /* With the priority index, each pending TCB can just be removed from the
+   * pending task list and added to the ready-to-run list directly.
+   */
+
+  while ((ptcb = (FAR struct tcb_s *)g_pendingtasks.head) != NULL)
+    {
+      nxsched_prioindex_remove((FAR dq_queue_t *)&g_pendingtasks, ptcb);
+      dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
+
+      rtcb = this_task();
+      if (nxsched_add_prioritized(ptcb, (FAR dq_queue_t *)&g_readytorun))
+        {
+          /* The ptcb was added at the head of the ready-to-run list */
+
+          rtcb->task_state = TSTATE_TASK_READYTORUN;
+          ptcb->task_state = TSTATE_TASK_RUNNING;
+          ret              = true;
+        }
+      else
+        {
+          ptcb->task_state = TSTATE_TASK_READYTORUN;
+        }
+    }
+
+#else
   /* Initialize the inner search loop */
 
   rtcb = this_task();
@@ -147,6 +175,7 @@ bool nxsched_merge_pending(void)
 
   g_pendingtasks.head = NULL;
   g_pendingtasks.tail = NULL;
+#endif /* CONFIG_SCHED_PRIOINDEX */
 
   return ret;
 }
@@ -223,6 +252,7 @@ bool nxsched_merge_pending(void)
         {
           /* Remove the task from the pending task list */
 
+          nxsched_prioindex_remove((FAR dq_queue_t *)&g_pendingtasks, ptcb);
           tcb = (FAR struct tcb_s *)
             dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
 
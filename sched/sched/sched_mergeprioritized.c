@@ -63,9 +63,11 @@
 void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
                                uint8_t task_state)
 {
+#ifndef CONFIG_SCHED_PRIOINDEX
   dq_queue_t clone;
   FAR struct tcb_s *tcb1;
   FAR struct tcb_s *tcb2;
+#endif
   FAR struct tcb_s *tmp;
 
 #ifdef CONFIG_SMP
@@ -76,6 +78,24 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
   DEBUGASSERT(list1 != NULL && list2 != NULL);
 
+#ifdef CONFIG_SCHED_PRIOINDEX
+  /* Both lists are indexed by priority so each TCB can simply be moved
+   * from list1 to its place in list2 without walking list2.  The TCBs of
+   * list1 go after any TCBs of the same priority already in list2, just as
+   * with the merge below.
+   */
+
+  while ((tmp = (FAR struct tcb_s *)dq_peek(list1)) != NULL)
+    {
+      nxsched_prioindex_remove(list1, tmp);
+      dq_remfirst(list1);
+
+      tmp->task_state = task_state;
+      nxsched_add_prioritized(tmp, list2);
+    }
+
+#else
+
   /* Get a private copy of list1, clearing list1.  We do this early so that
    * we can be assured that the list is stationary before we start any
    * operations on it.
@@ -164,6 +184,7 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
   while (tcb1 != NULL);
 
 ret_with_lock:
+#endif /* CONFIG_SCHED_PRIOINDEX */
 
 #ifdef CONFIG_SMP
   /* Unlock the tasklists */
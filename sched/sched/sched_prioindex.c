@@ -0,0 +1,249 @@
+/****************************************************************************
+ * sched/sched/sched_prioindex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PRIOINDEX_WORD(p)  ((p) >> 5)
+#define PRIOINDEX_BIT(p)   ((uint32_t)1 << ((p) & 31))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The priority indexes of the ready-to-run and pending task lists */
+
+static struct prioindex_s g_readytorunindex;
+static struct prioindex_s g_pendingindex;
+
+#ifdef CONFIG_SMP
+static struct prioindex_s g_assignedindex[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_prioindex
+ *
+ * Description:
+ *   Return the priority index associated with a task list.  Only the
+ *   lists that can hold ready-to-run tasks are indexed.
+ *
+ * Input Parameters:
+ *   list - The task list
+ *
+ * Returned Value:
+ *   The priority index of the list or NULL if the list is not indexed.
+ *
+ ****************************************************************************/
+
+static FAR struct prioindex_s *nxsched_prioindex(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorunindex;
+    }
+  else if (list == (FAR dq_queue_t *)&g_pendingtasks)
+    {
+      return &g_pendingindex;
+    }
+#ifdef CONFIG_SMP
+  else if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+           list <  (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedindex[list - (FAR dq_queue_t *)g_assignedtasks];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_prioindex_find
+ *
+ * Description:
+ *   Find the position where a TCB of the given priority should be inserted
+ *   into an indexed, prioritized task list.  The TCB goes after all of the
+ *   TCBs of the same or higher priority.  The search is a find-first-set
+ *   over the priority bitmap and does not depend on the length of the list.
+ *
+ * Input Parameters:
+ *   list - The prioritized task list
+ *   sched_priority - The priority of the TCB to be inserted
+ *   tcb  - Location to return the TCB that the new TCB should follow.  NULL
+ *          is returned if the new TCB belongs at the head of the list.
+ *
+ * Returned Value:
+ *   true if the list is indexed and the position was returned in 'tcb'.
+ *   false if the list is not indexed and must be searched.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+bool nxsched_prioindex_find(FAR dq_queue_t *list, uint8_t sched_priority,
+                            FAR struct tcb_s **tcb)
+{
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+  uint32_t map;
+  int word;
+
+  if (index == NULL)
+    {
+      return false;
+    }
+
+  /* Find the lowest priority that is present in the list and that is
+   * greater than or equal to the priority of the new TCB.
+   */
+
+  word = PRIOINDEX_WORD(sched_priority);
+  map  = index->map[word] & ~(PRIOINDEX_BIT(sched_priority) - 1);
+
+  while (map == 0)
+    {
+      if (++word >= PRIOINDEX_NWORDS)
+        {
+          /* There are no TCBs of the same or higher priority */
+
+          *tcb = NULL;
+          return true;
+        }
+
+      map = index->map[word];
+    }
+
+  *tcb = index->tail[(word << 5) + ffs((int)map) - 1];
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxsched_prioindex_add
+ *
+ * Description:
+ *   Update the priority index after a TCB has been linked into a
+ *   prioritized task list.  The TCB must have been placed consistent with
+ *   the priority ordering of the list.
+ *
+ * Input Parameters:
+ *   list - The prioritized task list that now holds the TCB
+ *   tcb  - The TCB that was added
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_prioindex_add(FAR dq_queue_t *list, FAR struct tcb_s *tcb)
+{
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+  FAR struct tcb_s *next;
+  uint8_t sched_priority;
+
+  if (index != NULL)
+    {
+      /* The TCB is the new tail of its priority unless it was inserted in
+       * front of another TCB of the same priority.
+       */
+
+      sched_priority = tcb->sched_priority;
+      next           = tcb->flink;
+
+      if (next == NULL || next->sched_priority != sched_priority)
+        {
+          index->tail[sched_priority] = tcb;
+          index->map[PRIOINDEX_WORD(sched_priority)] |=
+            PRIOINDEX_BIT(sched_priority);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_prioindex_remove
+ *
+ * Description:
+ *   Update the priority index before a TCB is unlinked from a prioritized
+ *   task list.
+ *
+ * Input Parameters:
+ *   list - The prioritized task list that holds the TCB
+ *   tcb  - The TCB that is about to be removed
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_prioindex_remove(FAR dq_queue_t *list, FAR struct tcb_s *tcb)
+{
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+  FAR struct tcb_s *prev;
+  uint8_t sched_priority;
+
+  if (index != NULL)
+    {
+      sched_priority = tcb->sched_priority;
+      if (index->tail[sched_priority] == tcb)
+        {
+          /* The TCB before this one becomes the new tail of the priority,
+           * if there is one of the same priority.
+           */
+
+          prev = tcb->blink;
+          if (prev != NULL && prev->sched_priority == sched_priority)
+            {
+              index->tail[sched_priority] = prev;
+            }
+          else
+            {
+              index->tail[sched_priority] = NULL;
+              index->map[PRIOINDEX_WORD(sched_priority)] &=
+                ~PRIOINDEX_BIT(sched_priority);
+            }
+        }
+    }
+}
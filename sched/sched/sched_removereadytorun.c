@@ -102,6 +102,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  nxsched_prioindex_remove((FAR dq_queue_t *)&g_readytorun, rtcb);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -199,6 +200,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      nxsched_prioindex_remove(tasklist, rtcb);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -231,20 +233,21 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
 
       if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority)
         {
-          FAR struct tcb_s *tmptcb;
-
-          /* The TCB at the head of the ready to run list has the higher
-           * priority.  Remove that task from the head of the g_readytorun
-           * list and add to the head of the g_assignedtasks[cpu] list.
+          /* The TCB from the ready to run list has the higher priority.
+           * Remove that task from the g_readytorun list and add to the
+           * head of the g_assignedtasks[cpu] list.  This is not
+           * necessarily the head of g_readytorun:  Higher priority tasks
+           * ahead of it may not be permitted to run on this CPU.
            */
 
-          tmptcb = (FAR struct tcb_s *)
-            dq_remfirst((FAR dq_queue_t *)&g_readytorun);
+          nxsched_prioindex_remove((FAR dq_queue_t *)&g_readytorun, rtrtcb);
+          dq_rem((FAR dq_entry_t *)rtrtcb, (FAR dq_queue_t *)&g_readytorun);
 
-          dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
+          nxsched_prioindex_add(tasklist, rtrtcb);
 
-          tmptcb->cpu = cpu;
-          nxttcb = tmptcb;
+          rtrtcb->cpu = cpu;
+          nxttcb = rtrtcb;
         }
 
       /* Will pre-emption be disabled after the switch?  If the lockcount is
@@ -329,6 +332,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      nxsched_prioindex_remove(tasklist, rtcb);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
@@ -122,6 +122,9 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
                                                int sched_priority)
 {
   FAR struct tcb_s *nxttcb;
+#ifdef CONFIG_SCHED_PRIOINDEX
+  FAR dq_queue_t *tasklist;
+#endif
 
   /* Get the TCB of the next highest priority, ready to run task */
 
@@ -149,9 +152,25 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_PRIOINDEX
+      /* The task stays at the head of its list, but it must be moved to
+       * its new priority in the priority index of that list.
+       */
+
+#ifdef CONFIG_SMP
+      tasklist = TLIST_HEAD(tcb->task_state, tcb->cpu);
+#else
+      tasklist = TLIST_HEAD(tcb->task_state);
+#endif
+
+      nxsched_prioindex_remove(tasklist, tcb);
+      tcb->sched_priority = (uint8_t)sched_priority;
+      nxsched_prioindex_add(tasklist, tcb);
+#else
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+#endif
     }
 }
 
@@ -283,6 +302,7 @@ static inline void nxsched_blocked_setpriority(FAR struct tcb_s *tcb,
     {
       /* Remove the TCB from the prioritized task list */
 
+      nxsched_prioindex_remove(tasklist, tcb);
       dq_rem((FAR dq_entry_t *)tcb, tasklist);
 
       /* Change the task priority */
@@ -117,7 +117,7 @@ int nxsem_clockwait(FAR sem_t *sem, clockid_t clockid,
    * enabled while we are blocked waiting for the semaphore.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
   /* Try to take the semaphore without waiting. */
 
@@ -182,7 +182,7 @@ int nxsem_clockwait(FAR sem_t *sem, clockid_t clockid,
 
 success_with_irqdisabled:
 errout_with_irqdisabled:
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
   return ret;
 }
 
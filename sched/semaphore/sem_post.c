@@ -82,13 +82,13 @@ int nxsem_post(FAR sem_t *sem)
        * handler.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
       /* Check the maximum allowable value */
 
       if (sem->semcount >= SEM_VALUE_MAX)
         {
-          leave_critical_section(flags);
+          spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
           return -EOVERFLOW;
         }
 
@@ -178,7 +178,7 @@ int nxsem_post(FAR sem_t *sem)
 
       /* Interrupts may now be enabled. */
 
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
     }
 
   return ret;
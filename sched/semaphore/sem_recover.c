@@ -92,7 +92,7 @@ void nxsem_recover(FAR struct tcb_s *tcb)
    * enforce that here).
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
   if (tcb->task_state == TSTATE_WAIT_SEM)
     {
       sem_t *sem = tcb->waitsem;
@@ -121,5 +121,5 @@ void nxsem_recover(FAR struct tcb_s *tcb)
       tcb->waitsem = NULL;
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
 }
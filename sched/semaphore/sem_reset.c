@@ -86,7 +86,7 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
    * performing this operation.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
   /* A negative count indicates that the negated number of threads are
    * waiting to take a count from the semaphore.  Loop here, handing
@@ -118,7 +118,7 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
 
   /* Allow any pending context switches to occur now */
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
   sched_unlock();
   return OK;
 }
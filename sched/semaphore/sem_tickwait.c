@@ -84,7 +84,7 @@ int nxsem_tickwait(FAR sem_t *sem, clock_t start, uint32_t delay)
    * enabled while we are blocked waiting for the semaphore.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
   /* Try to take the semaphore without waiting. */
 
@@ -144,7 +144,7 @@ success_with_irqdisabled:
   /* Error exits */
 
 errout_with_irqdisabled:
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
   return ret;
 }
 
@@ -77,7 +77,7 @@ void nxsem_timeout(wdparm_t pid)
 
   /* Disable interrupts to avoid race conditions */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
   /* Get the TCB associated with this PID.  It is possible that
    * task may no longer be active when this watchdog goes off.
@@ -98,5 +98,5 @@ void nxsem_timeout(wdparm_t pid)
 
   /* Interrupts may now be enabled. */
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
 }
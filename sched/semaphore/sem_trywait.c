@@ -93,7 +93,7 @@ int nxsem_trywait(FAR sem_t *sem)
        * because sem_post() may be called from an interrupt handler.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
       /* If the semaphore is available, give it to the requesting task */
 
@@ -114,7 +114,7 @@ int nxsem_trywait(FAR sem_t *sem)
 
       /* Interrupts may now be enabled. */
 
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
     }
   else
     {
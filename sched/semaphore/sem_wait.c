@@ -82,7 +82,7 @@ int nxsem_wait(FAR sem_t *sem)
    * handler.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
   /* Make sure we were supplied with a valid semaphore. */
 
@@ -190,7 +190,7 @@ int nxsem_wait(FAR sem_t *sem)
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
   return ret;
 }
 
@@ -71,7 +71,7 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
    * doing this.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_SEMAPHORE);
 
   /* It is possible that an interrupt/context switch beat us to the punch
    * and already changed the task's state.
@@ -111,5 +111,5 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
 
   /* Interrupts may now be enabled. */
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_SEMAPHORE, flags);
 }
@@ -157,6 +157,7 @@ int nxtask_terminate(pid_t pid, bool nonblocking)
 
   /* Remove the task from the task list */
 
+  nxsched_prioindex_remove(tasklist, dtcb);
   dq_rem((FAR dq_entry_t *)dtcb, tasklist);
   dtcb->task_state = TSTATE_TASK_INVALID;
 
@@ -57,8 +57,10 @@
 
 int wd_cancel(FAR struct wdog_s *wdog)
 {
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -66,7 +68,7 @@ int wd_cancel(FAR struct wdog_s *wdog)
    * cancellation is complete
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
 
   /* Make sure that the watchdog is initialized (non-NULL) and is still
    * active.
@@ -74,6 +76,16 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      /* Remove the watchdog from its timing wheel slot.  If that emptied
+       * the slot, then the next interval event may have changed.
+       */
+
+      if (wd_wheel_remove(wdog))
+        {
+          nxsched_reassess_timer();
+        }
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -124,9 +136,11 @@ int wd_cancel(FAR struct wdog_s *wdog)
           nxsched_reassess_timer();
         }
 
+      wdog->next = NULL;
+#endif /* CONFIG_WDOG_TIMERWHEEL */
+
       /* Mark the watchdog inactive */
 
-      wdog->next = NULL;
       WDOG_CLRACTIVE(wdog);
 
       /* Return success */
@@ -134,6 +148,6 @@ int wd_cancel(FAR struct wdog_s *wdog)
       ret = OK;
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
   return ret;
 }
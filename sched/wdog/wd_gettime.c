@@ -56,9 +56,17 @@ int wd_gettime(FAR struct wdog_s *wdog)
 
   /* Verify the wdog */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      /* The absolute expiration time is kept in the watchdog */
+
+      int delay = (int)(wdog->expire - g_wdwheel.now - wd_elapse());
+
+      spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -74,12 +82,13 @@ int wd_gettime(FAR struct wdog_s *wdog)
           if (curr == wdog)
             {
               delay -= wd_elapse();
-              leave_critical_section(flags);
+              spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
               return delay;
             }
         }
+#endif
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
   return 0;
 }
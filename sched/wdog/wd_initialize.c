@@ -32,6 +32,7 @@
  * Public Data
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
@@ -46,6 +47,7 @@ sq_queue_t g_wdactivelist;
 #ifdef CONFIG_SCHED_TICKLESS
 clock_t g_wdtickbase;
 #endif
+#endif /* !CONFIG_WDOG_TIMERWHEEL */
 
 /****************************************************************************
  * Public Functions
@@ -72,7 +74,13 @@ clock_t g_wdtickbase;
 
 void wd_initialize(void)
 {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  /* Initialize the watchdog timing wheel */
+
+  wd_wheel_initialize();
+#else
   /* Initialize watchdog lists */
 
   sq_init(&g_wdactivelist);
+#endif
 }
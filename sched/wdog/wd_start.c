@@ -54,6 +54,7 @@
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -108,6 +109,7 @@ static inline void wd_expiration(void)
         }
     }
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -152,10 +154,12 @@ static inline void wd_expiration(void)
 int wd_start(FAR struct wdog_s *wdog, int32_t delay,
              wdentry_t wdentry, wdparm_t arg)
 {
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
 
   /* Verify the wdog and setup parameters */
@@ -171,7 +175,7 @@ int wd_start(FAR struct wdog_s *wdog, int32_t delay,
    * the critical section is established.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
   if (WDOG_ISACTIVE(wdog))
     {
       wd_cancel(wdog);
@@ -204,6 +208,22 @@ int wd_start(FAR struct wdog_s *wdog, int32_t delay,
   nxsched_cancel_timer();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+  /* If the wheel is empty, just bring its time base up to date */
+
+  if (wd_wheel_empty())
+    {
+      g_wdwheel.now = clock_systime_ticks();
+    }
+#endif
+
+  /* File the watchdog in the wheel slot for its expiration time */
+
+  wdog->expire = g_wdwheel.now + delay;
+  wd_wheel_insert(wdog);
+
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -294,9 +314,13 @@ int wd_start(FAR struct wdog_s *wdog, int32_t delay,
         }
     }
 
-  /* Put the lag into the watchdog structure and mark it as active. */
+  /* Put the lag into the watchdog structure. */
 
   wdog->lag = delay;
+#endif /* CONFIG_WDOG_TIMERWHEEL */
+
+  /* Mark the watchdog as active. */
+
   WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -308,10 +332,11 @@ int wd_start(FAR struct wdog_s *wdog, int32_t delay,
   nxsched_resume_timer();
 #endif
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
   return OK;
 }
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /****************************************************************************
  * Name: wd_timer
  *
@@ -357,7 +382,7 @@ unsigned int wd_timer(int ticks)
    * SMP case.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
 #endif
 
   /* Check if there are any active watchdogs to process */
@@ -401,7 +426,7 @@ unsigned int wd_timer(int ticks)
           ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
 
 #ifdef CONFIG_SMP
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
 #endif
 
   /* Return the delay for the next watchdog to expire */
@@ -424,7 +449,7 @@ void wd_timer(void)
    * SMP case.
    */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
 #endif
 
   /* Check if there are any active watchdogs to process */
@@ -441,7 +466,8 @@ void wd_timer(void)
     }
 
 #ifdef CONFIG_SMP
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
 #endif
 }
 #endif /* CONFIG_SCHED_TICKLESS */
+#endif /* !CONFIG_WDOG_TIMERWHEEL */
@@ -0,0 +1,488 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All bits of a per-level pending bitmap */
+
+#define WDOG_WHEEL_ALLSLOTS  (0xffffffff >> (32 - WDOG_WHEEL_SLOTS))
+
+/* Delays that do not fit in the wheel are filed in the outermost level as
+ * if they had the longest delay that does fit.  They are re-filed each time
+ * that outermost slot is cascaded until they finally fit.
+ */
+
+#if WDOG_WHEEL_SHIFT(WDOG_WHEEL_LEVELS) < 31
+#  define WDOG_WHEEL_MAXDELAY \
+     ((clock_t)((1 << WDOG_WHEEL_SHIFT(WDOG_WHEEL_LEVELS)) - 1))
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The timing wheel that holds all active watchdogs */
+
+struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-file all of the watchdogs in the current slot of an outer level into
+ *   the finer-grained levels below it.  Called when all of the levels
+ *   below 'level' have completed a full turn.
+ *
+ * Input Parameters:
+ *   level - The outer level to be cascaded (1..WDOG_WHEEL_LEVELS-1)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s *next;
+  dq_queue_t list;
+  int index;
+
+  index = (g_wdwheel.now >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+  if ((g_wdwheel.pending[level] & ((uint32_t)1 << index)) == 0)
+    {
+      return;
+    }
+
+  /* Detach the whole slot, then re-file each watchdog.  None of them can
+   * land back in this same slot.
+   */
+
+  dq_move(&g_wdwheel.slot[level * WDOG_WHEEL_SLOTS + index], &list);
+  g_wdwheel.pending[level] &= ~((uint32_t)1 << index);
+
+  for (wdog = (FAR struct wdog_s *)list.head; wdog != NULL; wdog = next)
+    {
+      next = wdog->next;
+      wd_wheel_insert(wdog);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expiration
+ *
+ * Description:
+ *   Process the timing wheel at the current time (g_wdwheel.now):  Cascade
+ *   any outer levels that have come around and run every watchdog in the
+ *   current level 0 slot.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void wd_wheel_expiration(void)
+{
+  FAR struct wdog_s *wdog;
+  FAR dq_queue_t *slot;
+  int level;
+  int index;
+
+  /* Cascade each level whose inner levels have just turned over */
+
+  for (level = 1;
+       level < WDOG_WHEEL_LEVELS &&
+       ((g_wdwheel.now >> WDOG_WHEEL_SHIFT(level - 1)) & WDOG_WHEEL_MASK)
+         == 0;
+       level++)
+    {
+      wd_wheel_cascade(level);
+    }
+
+  /* Now run all of the watchdogs in the current slot of level 0 */
+
+  index = g_wdwheel.now & WDOG_WHEEL_MASK;
+  slot  = &g_wdwheel.slot[index];
+
+  while ((wdog = (FAR struct wdog_s *)dq_remfirst(slot)) != NULL)
+    {
+      if (dq_empty(slot))
+        {
+          g_wdwheel.pending[0] &= ~((uint32_t)1 << index);
+        }
+
+      wdog->next = NULL;
+      wdog->prev = NULL;
+
+      /* A watchdog function may have re-entered the timer logic and
+       * advanced the wheel while we were draining this slot.  Anything
+       * that is not yet due is simply re-filed.
+       */
+
+      if ((sclock_t)(wdog->expire - g_wdwheel.now) > 0)
+        {
+          wd_wheel_insert(wdog);
+          continue;
+        }
+
+      /* Indicate that the watchdog is no longer active. */
+
+      WDOG_CLRACTIVE(wdog);
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(wdog->picbase);
+      wdog->func(wdog->arg);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks from g_wdwheel.now until the wheel next
+ *   needs attention:  Either a level 0 slot with watchdogs to run or an
+ *   outer slot with watchdogs to cascade.  The cost is O(levels).
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The number of ticks until the next wheel event or zero if the wheel is
+ *   empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+static clock_t wd_wheel_next(void)
+{
+  clock_t ret = 0;
+  clock_t base;
+  clock_t delay;
+  uint32_t pending;
+  int start;
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      pending = g_wdwheel.pending[level];
+      if (pending == 0)
+        {
+          continue;
+        }
+
+      /* Rotate the bitmap so that bit 0 corresponds to the slot after the
+       * current one.  The first set bit is then the distance (in units of
+       * this level) to the next non-empty slot.
+       */
+
+      base  = g_wdwheel.now >> WDOG_WHEEL_SHIFT(level);
+      start = (base + 1) & WDOG_WHEEL_MASK;
+
+      if (start != 0)
+        {
+          pending = ((pending >> start) |
+                     (pending << (WDOG_WHEEL_SLOTS - start))) &
+                    WDOG_WHEEL_ALLSLOTS;
+        }
+
+      delay = ((base + ffs((int)pending)) << WDOG_WHEEL_SHIFT(level)) -
+              g_wdwheel.now;
+
+      if (ret == 0 || delay < ret)
+        {
+          ret = delay;
+        }
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timing wheel.  Called from wd_initialize().
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  int i;
+
+  g_wdwheel.now = 0;
+
+  for (i = 0; i < WDOG_WHEEL_LEVELS; i++)
+    {
+      g_wdwheel.pending[i] = 0;
+    }
+
+  for (i = 0; i < WDOG_WHEEL_NSLOTS; i++)
+    {
+      dq_init(&g_wdwheel.slot[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   File the watchdog in the timing wheel slot that corresponds to its
+ *   expiration time (wdog->expire).  This is an O(1) operation.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to be added.  The expire field must be set.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  clock_t delay = wdog->expire - g_wdwheel.now;
+  int level = 0;
+  int index;
+
+#ifdef WDOG_WHEEL_MAXDELAY
+  if (delay > WDOG_WHEEL_MAXDELAY)
+    {
+      delay = WDOG_WHEEL_MAXDELAY;
+    }
+#endif
+
+  /* Find the finest level that can represent this delay */
+
+  while (level < WDOG_WHEEL_LEVELS - 1 &&
+         (delay >> WDOG_WHEEL_SHIFT(level + 1)) != 0)
+    {
+      level++;
+    }
+
+  index = ((g_wdwheel.now + delay) >> WDOG_WHEEL_SHIFT(level)) &
+          WDOG_WHEEL_MASK;
+
+  wdog->slot = level * WDOG_WHEEL_SLOTS + index;
+  dq_addlast((FAR dq_entry_t *)wdog, &g_wdwheel.slot[wdog->slot]);
+  g_wdwheel.pending[level] |= ((uint32_t)1 << index);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove the watchdog from its timing wheel slot.  This is an O(1)
+ *   operation.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to be removed.
+ *
+ * Returned Value:
+ *   True is returned if the slot became empty as a consequence.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  FAR dq_queue_t *slot;
+
+  DEBUGASSERT(wdog->slot < WDOG_WHEEL_NSLOTS);
+
+  slot = &g_wdwheel.slot[wdog->slot];
+  dq_rem((FAR dq_entry_t *)wdog, slot);
+
+  wdog->next = NULL;
+  wdog->prev = NULL;
+
+  if (dq_empty(slot))
+    {
+      g_wdwheel.pending[wdog->slot / WDOG_WHEEL_SLOTS] &=
+        ~((uint32_t)1 << (wdog->slot & WDOG_WHEEL_MASK));
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_empty
+ *
+ * Description:
+ *   Return true if there are no active watchdogs in the timing wheel.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_empty(void)
+{
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (g_wdwheel.pending[level] != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: wd_timer
+ *
+ * Description:
+ *   This function is called from the timer interrupt handler to determine
+ *   if it is time to execute a watchdog function.  If so, the watchdog
+ *   function will be executed in the context of the timer interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   ticks - If CONFIG_SCHED_TICKLESS is defined then the number of ticks
+ *     in the interval that just expired is provided.  Otherwise,
+ *     this function is called on each timer interrupt and a value of one
+ *     is implicit.
+ *
+ * Returned Value:
+ *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
+ *   next delay is provided (zero if no delay).  Otherwise, this function
+ *   has no returned value.
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+unsigned int wd_timer(int ticks)
+{
+  clock_t next;
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+
+  /* We are in an interrupt handler as, as a consequence, interrupts are
+   * disabled.  But in the SMP case, interrupts MAY be disabled only on
+   * the local CPU since most architectures do not permit disabling
+   * interrupts on other CPUS.
+   *
+   * Hence, we must follow rules for critical sections even here in the
+   * SMP case.
+   */
+
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
+#endif
+
+  /* Advance the wheel, stopping only at the ticks where there is something
+   * to do.  Empty slots are skipped over in O(levels) time.
+   */
+
+  while (ticks > 0)
+    {
+      next = wd_wheel_next();
+      if (next == 0 || next > (clock_t)ticks)
+        {
+          g_wdwheel.now += ticks;
+          break;
+        }
+
+      g_wdwheel.now += next;
+      ticks         -= next;
+
+      wd_wheel_expiration();
+    }
+
+  /* Return the delay for the next watchdog to expire */
+
+  next = wd_wheel_next();
+
+#ifdef CONFIG_SMP
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
+#endif
+
+  return (unsigned int)next;
+}
+
+#else
+void wd_timer(void)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+
+  /* We are in an interrupt handler as, as a consequence, interrupts are
+   * disabled.  But in the SMP case, interrupts MAY be disabled only on
+   * the local CPU since most architectures do not permit disabling
+   * interrupts on other CPUS.
+   *
+   * Hence, we must follow rules for critical sections even here in the
+   * SMP case.
+   */
+
+  flags = spin_lock_irqsave_class(IRQLOCK_WDOG);
+#endif
+
+  /* Advance the wheel by one tick and run whatever became due */
+
+  g_wdwheel.now++;
+  wd_wheel_expiration();
+
+#ifdef CONFIG_SMP
+  spin_unlock_irqrestore_class(IRQLOCK_WDOG, flags);
+#endif
+}
+#endif /* CONFIG_SCHED_TICKLESS */
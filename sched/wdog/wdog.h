@@ -49,10 +49,25 @@
  *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_TICKLESS
-#  define wd_elapse() (clock_systime_ticks() - g_wdtickbase)
-#else
+#if !defined(CONFIG_SCHED_TICKLESS)
 #  define wd_elapse() (0)
+#elif defined(CONFIG_WDOG_TIMERWHEEL)
+#  define wd_elapse() (clock_systime_ticks() - g_wdwheel.now)
+#else
+#  define wd_elapse() (clock_systime_ticks() - g_wdtickbase)
+#endif
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/* Timing wheel geometry.  Level 0 has a resolution of one tick; each
+ * following level has a resolution of one full turn of the level below it.
+ */
+
+#  define WDOG_WHEEL_BITS     CONFIG_WDOG_TIMERWHEEL_BITS
+#  define WDOG_WHEEL_LEVELS   CONFIG_WDOG_TIMERWHEEL_LEVELS
+#  define WDOG_WHEEL_SLOTS    (1 << WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK     (WDOG_WHEEL_SLOTS - 1)
+#  define WDOG_WHEEL_NSLOTS   (WDOG_WHEEL_LEVELS * WDOG_WHEEL_SLOTS)
+#  define WDOG_WHEEL_SHIFT(l) (WDOG_WHEEL_BITS * (l))
 #endif
 
 /****************************************************************************
@@ -67,6 +82,23 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/* This is the hierarchical timing wheel that holds the active watchdogs.
+ * Each slot is a doubly linked list of watchdogs so that watchdogs can be
+ * added and removed in constant time.  The pending bitmaps record which
+ * slots of each level are non-empty.
+ */
+
+struct wd_wheel_s
+{
+  clock_t    now;                             /* Time of the last wheel tick */
+  uint32_t   pending[WDOG_WHEEL_LEVELS];      /* Non-empty slots per level */
+  dq_queue_t slot[WDOG_WHEEL_NSLOTS];         /* Lists of active watchdogs */
+};
+
+extern struct wd_wheel_s g_wdwheel;
+
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
@@ -81,6 +113,7 @@ extern sq_queue_t g_wdactivelist;
 #ifdef CONFIG_SCHED_TICKLESS
 extern clock_t g_wdtickbase;
 #endif
+#endif /* CONFIG_WDOG_TIMERWHEEL */
 
 /****************************************************************************
  * Public Function Prototypes
@@ -138,6 +171,68 @@ unsigned int wd_timer(int ticks);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timing wheel.  Called from wd_initialize().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+void wd_wheel_initialize(void);
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   File the watchdog in the timing wheel slot that corresponds to its
+ *   expiration time (wdog->expire).  This is an O(1) operation.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to be added.  The expire field must be set.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove the watchdog from its timing wheel slot.  This is an O(1)
+ *   operation.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to be removed.
+ *
+ * Returned Value:
+ *   True is returned if the slot became empty as a consequence.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_empty
+ *
+ * Description:
+ *   Return true if there are no active watchdogs in the timing wheel.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_empty(void);
+#endif
+
 /****************************************************************************
  * Name: wd_recover
  *
@@ -101,7 +101,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
    */
 
   next  = WORK_DELAY_MAX;
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(IRQLOCK_WQUEUE);
 
   /* Get the time that we started processing the queue in clock ticks. */
 
@@ -153,7 +153,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
                * performed... we don't have any idea how long this will take!
                */
 
-              leave_critical_section(flags);
+              spin_unlock_irqrestore_class(IRQLOCK_WQUEUE, flags);
               worker(arg);
 
               /* Now, unfortunately, since we re-enabled interrupts we don't
@@ -161,7 +161,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
                * back at the head of the list.
                */
 
-              flags = enter_critical_section();
+              flags = spin_lock_irqsave_class(IRQLOCK_WQUEUE);
               work  = (FAR struct work_s *)wqueue->q.head;
             }
           else
@@ -240,7 +240,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
       wqueue->worker[wndx].busy = true;
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(IRQLOCK_WQUEUE, flags);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */